@@ -0,0 +1,62 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* cost of a property copy: the generic do_assignment, used by every
+ * connector and assignment before, against the specialized copy they
+ * now resolve at construction */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/connector.h"
+
+#include "bench.h"
+
+using namespace djnn;
+
+static const int nb_iter = 2000000;
+
+static void
+compare (bench::Report& report, const std::string& label, AbstractProperty* src, AbstractProperty* dst)
+{
+  report.add ("do_assignment " + label, -1,
+              bench::ns_per_op (nb_iter, [=] () {AbstractAssignment::do_assignment (src, dst, true);}), "ns");
+  assignment_proc_t assign = AbstractAssignment::get_assignment_proc (src, dst);
+  report.add ("typed " + label, -1, bench::ns_per_op (nb_iter, [=] () {assign (src, dst, true);}), "ns");
+}
+
+int
+main ()
+{
+  bench::Report report ("assignment");
+  init_core ();
+  Component* root = new Component (nullptr, "root");
+  DoubleProperty* d1 = new DoubleProperty (root, "d1", 1.5);
+  DoubleProperty* d2 = new DoubleProperty (root, "d2", 0);
+  IntProperty* i1 = new IntProperty (root, "i1", 3);
+  TextProperty* t1 = new TextProperty (root, "t1", "a text longer than the small string buffer");
+  TextProperty* t2 = new TextProperty (root, "t2", "");
+  compare (report, "double -> double", d1, d2);
+  compare (report, "int -> double", i1, d2);
+  compare (report, "text -> text", t1, t2);
+
+  /* the whole path of a connector: set_value, coupling, graph execution */
+  new Connector (root, "c", d1, "", d2, "");
+  root->activation ();
+  double v = 0;
+  report.add ("connector set_value + exec", -1, bench::ns_per_op (nb_iter / 10, [&] () {
+    d1->set_value (v++, true);
+    Graph::instance ().exec ();
+  }), "ns");
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* shared by the benchmark programs: the results are written as one JSON
+ * object on the standard output when the program ends, and as text on the
+ * standard error for whoever runs it by hand. make bench gathers the
+ * objects of every program in $(build_dir)/bench/results.json:
+ *   { "program": "graph_exec", "results": [
+ *       { "name": "fan-out", "param": 1000, "value": 1234.5, "unit": "ns" }, ... ] } */
+
+#pragma once
+
+#include "core/utils-dev.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  class Report {
+  public:
+    Report (const std::string& program) : _program (program) {}
+    ~Report ()
+    {
+      std::cout << "{ \"program\": \"" << escape (_program) << "\", \"results\": [";
+      for (size_t i = 0; i < _results.size (); i++) {
+        const result_t& r = _results[i];
+        char value[32];
+        snprintf (value, sizeof (value), "%.6g", r.value);
+        std::cout << (i ? ",\n    " : "\n    ") << "{ \"name\": \"" << escape (r.name) << "\", ";
+        if (r.param >= 0)
+          std::cout << "\"param\": " << r.param << ", ";
+        std::cout << "\"value\": " << value << ", \"unit\": \"" << escape (r.unit) << "\" }";
+      }
+      std::cout << " ] }" << std::endl;
+    }
+    /* param is the size of the problem measured, -1 if there is none */
+    void add (const std::string& name, long param, double value, const std::string& unit)
+    {
+      _results.push_back ( { name, param, value, unit });
+      std::cerr << _program << ": " << name;
+      if (param >= 0)
+        std::cerr << " " << param;
+      std::cerr << ": " << value << " " << unit << std::endl;
+    }
+
+  private:
+    struct result_t {
+      std::string name;
+      long param;
+      double value;
+      std::string unit;
+    };
+    static std::string escape (const std::string& s)
+    {
+      std::string r;
+      for (char c : s) {
+        if (c == '"' || c == '\\')
+          r += '\\';
+        r += c;
+      }
+      return r;
+    }
+    std::string _program;
+    std::vector<result_t> _results;
+  };
+
+  /* time per call of f in ns: median of a few runs of iter calls each,
+   * after one call to warm up the caches and the pools */
+  template <typename F> double
+  ns_per_op (long iter, F f, int runs = 5)
+  {
+    f ();
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+      struct timespec start;
+      djnn::get_monotonic_time (&start);
+      for (long i = 0; i < iter; i++)
+        f ();
+      times.push_back (djnn::elapsed_ms (start) * 1e6 / iter);
+    }
+    std::sort (times.begin (), times.end ());
+    return times[runs / 2];
+  }
+
+}
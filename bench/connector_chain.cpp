@@ -0,0 +1,52 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* DoubleProperty::set_value propagated through a chain of n connectors,
+ * d0 -> d1 -> ... -> dn, the graph being executed after each value */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/connector.h"
+
+#include "bench.h"
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("connector_chain");
+  init_core ();
+  for (int n : { 1, 10, 100, 1000 }) {
+    Component* root = new Component (nullptr, "root");
+    DoubleProperty* first = new DoubleProperty (root, "d0", 0);
+    DoubleProperty* prev = first;
+    for (int i = 1; i <= n; i++) {
+      DoubleProperty* d = new DoubleProperty (root, "d" + std::to_string (i), 0);
+      new Connector (root, "c" + std::to_string (i), prev, "", d, "");
+      prev = d;
+    }
+    root->activation ();
+    double v = 0;
+    double ns = bench::ns_per_op (std::max (100, 1000000 / n), [&] () {
+      first->set_value (v++, true);
+      Graph::instance ().exec ();
+    });
+    report.add ("set_value + exec", n, ns, "ns");
+    report.add ("per connector", n, ns / n, "ns");
+    root->deactivation ();
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* activation followed by deactivation of a component holding n children,
+ * each one made of two properties and a connector between them */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/connector.h"
+
+#include "bench.h"
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("container_activation");
+  init_core ();
+  for (int n : { 10, 100, 1000, 10000 }) {
+    Component* root = new Component (nullptr, "root");
+    for (int i = 0; i < n; i++) {
+      Component* c = new Component (root, "c" + std::to_string (i));
+      DoubleProperty* in = new DoubleProperty (c, "in", 0);
+      DoubleProperty* out = new DoubleProperty (c, "out", 0);
+      new Connector (c, "connector", in, "", out, "");
+    }
+    double ns = bench::ns_per_op (std::max (10, 100000 / n), [&] () {
+      root->activation ();
+      Graph::instance ().exec ();
+      root->deactivation ();
+      Graph::instance ().exec ();
+    });
+    report.add ("activation + deactivation", n, ns, "ns");
+    report.add ("per child", n, ns / n, "ns");
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* heap allocations made by DoubleProperty::set_value on a property driving a few couplings */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+
+#include "bench.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long> nb_allocs (0);
+
+void*
+operator new (size_t size)
+{
+  nb_allocs++;
+  void* p = malloc (size);
+  if (p == nullptr)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void* p) noexcept
+{
+  free (p);
+}
+
+void
+operator delete (void* p, size_t) noexcept
+{
+  free (p);
+}
+
+using namespace djnn;
+
+static void
+noop (Process*)
+{
+}
+
+int
+main ()
+{
+  const int nb_iter = 100000;
+  bench::Report report ("coupling_alloc");
+  init_core ();
+  Component* root = new Component (nullptr, "root");
+  DoubleProperty* p = new DoubleProperty (root, "p", 0);
+  for (int i = 0; i < 3; i++) {
+    NativeAction* a = new NativeAction (root, "a" + std::to_string (i), noop, nullptr, true);
+    new Coupling (p, ACTIVATION, a, ACTIVATION);
+  }
+  root->activation ();
+
+  /* warm up the containers of the graph */
+  p->set_value (0.0, true);
+  Graph::instance ().exec ();
+
+  long before = nb_allocs;
+  for (int i = 0; i < nb_iter; i++)
+    p->set_value ((double) i, true);
+  long set_value_allocs = nb_allocs - before;
+
+  before = nb_allocs;
+  for (int i = 0; i < nb_iter; i++) {
+    p->set_value ((double) i, true);
+    Graph::instance ().exec ();
+  }
+  long exec_allocs = nb_allocs - before;
+
+  report.add ("set_value", -1, (double) set_value_allocs / nb_iter, "allocs");
+  report.add ("set_value + exec", -1, (double) exec_allocs / nb_iter, "allocs");
+  return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* lookup of a path of growing depth in a tree where each component has
+ * 16 children: find_component parsing the string on each call, against
+ * a PathRef split once */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "core/tree/path_ref.h"
+
+#include "bench.h"
+
+using namespace djnn;
+
+static const int breadth = 16;
+
+static void
+populate (Process* parent, int depth)
+{
+  if (depth == 0)
+    return;
+  for (int i = 0; i < breadth; i++) {
+    Component* c = new Component (parent, "child" + std::to_string (i));
+    /* only the last branch is expanded: the lookups go down that one */
+    if (i == breadth - 1)
+      populate (c, depth - 1);
+  }
+}
+
+int
+main ()
+{
+  bench::Report report ("find_component");
+  init_core ();
+  for (int depth : { 1, 2, 4, 8 }) {
+    Component* root = new Component (nullptr, "root");
+    populate (root, depth);
+    std::string path;
+    for (int d = 0; d < depth; d++)
+      path += (d ? "/child" : "child") + std::to_string (breadth - 1);
+    Process* found = nullptr;
+    report.add ("string", depth, bench::ns_per_op (1000000, [&] () {found = root->find_component (path);}), "ns");
+    PathRef ref (path);
+    report.add ("PathRef", depth, bench::ns_per_op (1000000, [&] () {found = ref.find (root);}), "ns");
+    if (found == nullptr)
+      std::cerr << "find_component: " << path << " not found" << std::endl;
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* cost of Graph::exec after a single set_value, on synthetic graphs of
+ * growing size, with both scheduling modes:
+ *  - fan-out: one property connected to n properties
+ *  - layers: n nodes in 10 layers, the adders of a layer summing two
+ *    results of the previous one. Adders rather than properties, since
+ *    connectors propagate immediately: a property fed by two connectors
+ *    would double the work at each layer */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/base.h"
+#include "base/connector.h"
+
+#include "bench.h"
+
+using namespace djnn;
+
+static const int sizes[] = { 10, 100, 1000, 10000 };
+
+static Component*
+build_fan_out (int n, DoubleProperty*& src)
+{
+  Component* root = new Component (nullptr, "root");
+  src = new DoubleProperty (root, "src", 0);
+  for (int i = 0; i < n; i++) {
+    DoubleProperty* dst = new DoubleProperty (root, "d" + std::to_string (i), 0);
+    new Connector (root, "c" + std::to_string (i), src, "", dst, "");
+  }
+  return root;
+}
+
+static Component*
+build_layers (int n, DoubleProperty*& src)
+{
+  const int nb_layers = 10;
+  int width = std::max (1, n / nb_layers);
+  Component* root = new Component (nullptr, "root");
+  src = new DoubleProperty (root, "src", 0);
+  std::vector<Process*> prev;
+  for (int i = 0; i < width; i++) {
+    DoubleProperty* p = new DoubleProperty (root, "p" + std::to_string (i), 0);
+    new Connector (root, "c" + std::to_string (i), src, "", p, "");
+    prev.push_back (p);
+  }
+  int k = 0;
+  for (int l = 1; l < nb_layers; l++) {
+    std::vector<Process*> cur;
+    for (int i = 0; i < width; i++, k++) {
+      Adder* a = new Adder (root, "a" + std::to_string (k), 0, 0);
+      new Connector (root, "l" + std::to_string (k), prev[i], "", a, "left");
+      new Connector (root, "r" + std::to_string (k), prev[(i + 1) % width], "", a, "right");
+      cur.push_back (a->find_component ("result"));
+    }
+    prev = cur;
+  }
+  return root;
+}
+
+static void
+measure (bench::Report& report, const std::string& label, Component* (*build) (int, DoubleProperty*&))
+{
+  for (scheduling_mode_t mode : { SCAN_SCHEDULING, WORKLIST_SCHEDULING }) {
+    Graph::instance ().set_scheduling_mode (mode);
+    for (int n : sizes) {
+      DoubleProperty* src;
+      Component* root = build (n, src);
+      root->activation ();
+      Graph::instance ().exec ();
+      double v = 0;
+      double ns = bench::ns_per_op (std::max (10, 2000000 / n), [&] () {
+        src->set_value (v++, true);
+        Graph::instance ().exec ();
+      });
+      report.add (label + (mode == SCAN_SCHEDULING ? " scan" : " worklist"), n, ns, "ns");
+      root->deactivation ();
+      delete root;
+    }
+  }
+}
+
+int
+main ()
+{
+  bench::Report report ("graph_exec");
+  init_core ();
+  init_base ();
+  measure (report, "fan-out", build_fan_out);
+  measure (report, "layers", build_layers);
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* n images of the same 64x64 file in an 800x600 offscreen window: time
+ * until they are all drawn, the file being decoded by the image cache
+ * thread, memory held by the cache, and cost of a full redraw after that */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "core/syshook/syshook.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+#include "gui/image_cache.h"
+#include "gui/soft/soft_window.h"
+
+#include "../bench.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("images");
+  const char *file = "bench_icon.ppm";
+  {
+    std::ofstream out (file, std::ios::binary);
+    out << "P6\n64 64\n255\n";
+    for (int i = 0; i < 64 * 64; i++) {
+      out.put (i % 256);
+      out.put (i / 64 * 4);
+      out.put (128);
+    }
+  }
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  for (int n : { 100, 500 }) {
+    ImageCache::instance ().clear ();
+    Component* root = new Component (nullptr, "root");
+    Window* w = new Window (root, "w", "bench", 0, 0, 800, 600);
+    for (int i = 0; i < n; i++)
+      new Image (root, "i" + std::to_string (i), file, (i * 37) % 760, (i * 53) % 560, 32, 32);
+    struct timespec start;
+    get_monotonic_time (&start);
+    root->activation ();
+    Graph::instance ().exec ();
+    SoftWindow* sw = dynamic_cast<SoftWindow*> (w->win_impl ());
+    sw->redraw ();
+    /* the main loop would let the cache thread in */
+    release_exclusive_access (DBG_REL);
+    ImageCache::instance ().wait_idle ();
+    get_exclusive_access (DBG_GET);
+    sw->redraw ();
+    report.add ("all drawn", n, elapsed_ms (start) * 1000, "us");
+    report.add ("cache", n, ImageCache::instance ().used (), "bytes");
+    double ns = bench::ns_per_op (10, [&] () {w->damage ().add_all (); sw->redraw ();});
+    report.add ("redraw", n, ns / 1000, "us");
+    root->deactivation ();
+    delete root;
+  }
+  std::remove (file);
+  return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* a table of n static labels in an 800x600 offscreen window: full redraw,
+ * whose text layouts are all reused, then the change of one label */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+#include "gui/soft/soft_window.h"
+
+#include "../bench.h"
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("labels");
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  for (int n : { 100, 1000 }) {
+    Component* root = new Component (nullptr, "root");
+    Window* w = new Window (root, "w", "bench", 0, 0, 800, 600);
+    new FontSize (root, "fs", 0, 10);
+    for (int i = 0; i < n; i++)
+      new Text (root, "t" + std::to_string (i), (i % 8) * 100, 12 + (i / 8) % 48 * 12,
+                "cell " + std::to_string (i) + " \xc3\xa9t\xc3\xa9");
+    root->activation ();
+    Graph::instance ().exec ();
+    SoftWindow* sw = dynamic_cast<SoftWindow*> (w->win_impl ());
+    double ns = bench::ns_per_op (std::max (1, 1000 / n), [&] () {w->damage ().add_all (); sw->redraw ();});
+    report.add ("redraw", n, ns / 1000, "us");
+    TextProperty *text = dynamic_cast<TextProperty*> (root->find_component ("t0/text"));
+    int step = 0;
+    ns = bench::ns_per_op (std::max (1, 10000 / n), [&] () {
+      text->set_value (++step % 2 ? "changed" : "cell 0", true);
+      Graph::instance ().exec ();
+      sw->redraw ();
+    });
+    report.add ("change one", n, ns / 1000, "us");
+    root->deactivation ();
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* many frames of a 400x300 offscreen window holding 12 panels, each a
+ * component with its own transforms, clip and style, and a nested one
+ * clipped again, one panel turning at each frame: the time of a frame at
+ * the start and at the end of the run, and what the resident memory grew
+ * by in between, which stays near zero unless the drawing contexts leak */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+#include "gui/soft/soft_window.h"
+
+#include "../bench.h"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace djnn;
+
+/* resident set size in KB, 0 where /proc is not there; read without
+ * stdio, whose buffer would be counted in the growth */
+static long
+rss_kb ()
+{
+  char buf[128];
+  long pages = 0, resident = 0;
+  int fd = open ("/proc/self/statm", O_RDONLY);
+  if (fd < 0)
+    return 0;
+  ssize_t len = read (fd, buf, sizeof (buf) - 1);
+  close (fd);
+  if (len <= 0)
+    return 0;
+  buf[len] = '\0';
+  if (sscanf (buf, "%ld %ld", &pages, &resident) != 2)
+    return 0;
+  return resident * (sysconf (_SC_PAGESIZE) / 1024);
+}
+
+int
+main ()
+{
+  bench::Report report ("long_draw");
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  const int n = 12, frames = 1000, block = 100;
+  Component* root = new Component (nullptr, "root");
+  Window* w = new Window (root, "w", "bench", 0, 0, 400, 300);
+  for (int i = 0; i < n; i++) {
+    std::string k = std::to_string (i);
+    double x = (i % 4) * 100, y = (i / 4) * 100;
+    Component* panel = new Component (root, "p" + k);
+    new Translation (panel, "t", x, y);
+    new Rotation (panel, "r", 0, 50, 50);
+    new RectangleClip (panel, "clip", 0, 0, 100, 100);
+    new FillColor (panel, "f", (i * 7) % 256, (i * 13) % 256, (i * 29) % 256);
+    new OutlineWidth (panel, "ow", 1 + i % 3);
+    new Rectangle (panel, "bg", -10, -10, 120, 120, 0, 0);
+    new Circle (panel, "c", 50, 50, 30);
+    Component* inner = new Component (panel, "inner");
+    new Scaling (inner, "s", 0.5, 0.5, 50, 50);
+    new RectangleClip (inner, "clip", 10, 10, 80, 80);
+    new FillColor (inner, "f", 255, 255, 255);
+    new Rectangle (inner, "r", 0, 0, 100, 100, 8, 8);
+  }
+  root->activation ();
+  Graph::instance ().exec ();
+  SoftWindow* sw = dynamic_cast<SoftWindow*> (w->win_impl ());
+  int frame = 0;
+  auto draw_frame = [&] () {
+    DoubleProperty *a = dynamic_cast<DoubleProperty*> (root->find_component ("p" + std::to_string (frame % n) + "/r/a"));
+    a->set_value (frame++ % 360, true);
+    Graph::instance ().exec ();
+    w->damage ().add_all ();
+    sw->redraw ();
+  };
+  /* the growth is counted from the end of the first block, the pools and
+   * the caches being warm by then, and the code of rss_kb mapped */
+  long rss_start = rss_kb ();
+  double first = 0, last = 0;
+  for (int b = 0; b < frames / block; b++) {
+    double ns = bench::ns_per_op (block, draw_frame, 1);
+    if (b == 0) {
+      first = ns;
+      rss_start = rss_kb ();
+    }
+    last = ns;
+  }
+  long growth = rss_kb () - rss_start;
+  report.add ("frame, first frames", block, first / 1000, "us");
+  report.add ("frame, last frames", block, last / 1000, "us");
+  report.add ("resident memory growth", frames - block, growth, "KB");
+  root->deactivation ();
+  delete root;
+  return 0;
+}
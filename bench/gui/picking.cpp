@@ -0,0 +1,85 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* color and geometric picking of an 800x600 offscreen window holding n
+ * pickable shapes: cost of the creation of a shape, of a full frame, of a pick at a pseudo-random
+ * position, and of a small move followed by a pick over the shape moved,
+ * which brings the color picking view up to date there */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+#include "gui/soft/soft_window.h"
+
+#include "../bench.h"
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("picking");
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  for (int n : { 100, 1000 }) {
+    Component* root = new Component (nullptr, "root");
+    Window* w = new Window (root, "w", "bench", 0, 0, 800, 600);
+    struct timespec start;
+    get_monotonic_time (&start);
+    for (int i = 0; i < n; i++) {
+      std::string k = std::to_string (i);
+      double x = (i * 37) % 760, y = (i * 53) % 560;
+      Process *s;
+      if (i % 2)
+        s = new Rectangle (root, "s" + k, x, y, 30, 20, 4, 4);
+      else
+        s = new Circle (root, "s" + k, x, y, 12);
+      s->find_component ("press");
+    }
+    report.add ("create", n, elapsed_ms (start) * 1000 / n, "us");
+    root->activation ();
+    Graph::instance ().exec ();
+    SoftWindow* sw = dynamic_cast<SoftWindow*> (w->win_impl ());
+    const char* names[] = { "color", "geometric" };
+    picking_mode_t modes[] = { COLOR_PICKING, GEOMETRIC_PICKING };
+    for (int m = 0; m < 2; m++) {
+      w->set_picking_mode (modes[m]);
+      double ns = bench::ns_per_op (std::max (1, 1000 / n), [&] () {w->damage ().add_all (); sw->redraw ();});
+      report.add (std::string (names[m]) + " frame", n, ns / 1000, "us");
+      unsigned int seed = 1;
+      ns = bench::ns_per_op (100000, [&] () {
+        seed = seed * 1103515245 + 12345;
+        sw->picking_view ()->pick ((seed >> 8) % 800, (seed >> 20) % 600);
+      });
+      report.add (std::string (names[m]) + " pick", n, ns, "ns");
+      /* a shape moves, then the pointer goes over it */
+      DoubleProperty *cx = dynamic_cast<DoubleProperty*> (root->find_component ("s0/cx"));
+      int step = 0;
+      ns = bench::ns_per_op (std::max (1, 10000 / n), [&] () {
+        cx->set_value (20 + (++step % 2) * 10, true);
+        Graph::instance ().exec ();
+        sw->redraw ();
+        sw->picking_view ()->pick (cx->get_value (), 0);
+      });
+      report.add (std::string (names[m]) + " move one and pick", n, ns / 1000, "us");
+    }
+    root->deactivation ();
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* redraw of an 800x600 offscreen window holding n shapes, rectangles,
+ * circles and paths with a fill and an outline changing every ten shapes:
+ * the whole window, then only the damage left by one rectangle moving, and
+ * by one point of a path moving */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+#include "gui/soft/soft_window.h"
+
+#include "../bench.h"
+
+using namespace djnn;
+
+int
+main ()
+{
+  bench::Report report ("soft_draw");
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  for (int n : { 10, 100, 1000 }) {
+    Component* root = new Component (nullptr, "root");
+    Window* w = new Window (root, "w", "bench", 0, 0, 800, 600);
+    for (int i = 0; i < n; i++) {
+      std::string k = std::to_string (i);
+      double x = (i * 37) % 760, y = (i * 53) % 560;
+      if (i % 10 == 0) {
+        new FillColor (root, "f" + k, (i * 7) % 256, (i * 13) % 256, (i * 29) % 256);
+        new OutlineColor (root, "o" + k, 0, 0, (i * 3) % 256);
+        new OutlineWidth (root, "ow" + k, 1 + i % 3);
+      }
+      switch (i % 3) {
+        case 0:
+          new Rectangle (root, "s" + k, x, y, 30, 20, 4, 4);
+          break;
+        case 1:
+          new Circle (root, "s" + k, x, y, 12);
+          break;
+        default: {
+          Path* p = new Path (root, "s" + k);
+          new PathMove (p, "m", x, y);
+          new PathLine (p, "l", x + 20, y);
+          new PathCubic (p, "c", x + 30, y, x + 30, y + 20, x + 20, y + 20);
+          new PathLine (p, "l2", x, y + 20);
+          new PathClosure (p, "z");
+        }
+      }
+    }
+    root->activation ();
+    Graph::instance ().exec ();
+    SoftWindow* sw = dynamic_cast<SoftWindow*> (w->win_impl ());
+    double ns = bench::ns_per_op (std::max (1, 1000 / n), [&] () {w->damage ().add_all (); sw->redraw ();});
+    report.add ("redraw", n, ns / 1000, "us");
+    report.add ("per shape", n, ns / n, "ns");
+    DoubleProperty *x = dynamic_cast<DoubleProperty*> (root->find_component ("s0/x"));
+    int step = 0;
+    ns = bench::ns_per_op (std::max (1, 1000 / n), [&] () {
+      x->set_value (step++ % 2 ? 0 : 10, true);
+      Graph::instance ().exec ();
+      sw->redraw ();
+    });
+    report.add ("move one", n, ns / 1000, "us");
+    report.add ("move one damaged area", n, w->damaged_area ()->get_value (), "px");
+    /* a point of the first path moves: only that path is built again */
+    DoubleProperty *px = dynamic_cast<DoubleProperty*> (root->find_component ("s2/items/2/x"));
+    ns = bench::ns_per_op (std::max (1, 1000 / n), [&] () {
+      px->set_value (px->get_value () + (step++ % 2 ? -5 : 5), true);
+      Graph::instance ().exec ();
+      sw->redraw ();
+    });
+    report.add ("move one path point", n, ns / 1000, "us");
+    root->deactivation ();
+    delete root;
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* XML::djnLoadFromXML on generated SVG files of n shapes, rectangles,
+ * circles and paths in groups of ten with a style and a transform,
+ * followed by the deletion of the loaded tree; with the nodes allocated
+ * in the pools, then in an arena freed with the tree */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "core/xml/xml.h"
+#include "base/base.h"
+#include "display/display.h"
+#include "gui/gui.h"
+
+#include "../bench.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+using namespace djnn;
+
+static std::string
+generate (int n)
+{
+  std::string path = "/tmp/djnn-bench-" + std::to_string (n) + ".svg";
+  std::ofstream out (path);
+  out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"800\" height=\"600\">\n";
+  for (int i = 0; i < n; i++) {
+    int x = (i * 37) % 760, y = (i * 53) % 560;
+    if (i % 10 == 0)
+      out << (i ? "</g>\n" : "") << "<g id=\"g" << i / 10 << "\" transform=\"translate(" << i % 7 << "," << i % 5
+          << ")\" style=\"fill:#" << std::hex << std::setw (6) << std::setfill ('0')
+          << (0x102030 * (i / 10 + 1)) % 0xffffff << std::dec
+          << ";stroke:black;stroke-width:2\">\n";
+    switch (i % 3) {
+      case 0:
+        out << "<rect id=\"s" << i << "\" x=\"" << x << "\" y=\"" << y << "\" width=\"30\" height=\"20\" rx=\"4\"/>\n";
+        break;
+      case 1:
+        out << "<circle id=\"s" << i << "\" cx=\"" << x << "\" cy=\"" << y << "\" r=\"12\"/>\n";
+        break;
+      default:
+        out << "<path id=\"s" << i << "\" d=\"M " << x << " " << y << " l 20 0 c 10 0 10 20 0 20 l -20 0 z\"/>\n";
+    }
+  }
+  out << (n ? "</g>\n" : "") << "</svg>\n";
+  return path;
+}
+
+int
+main ()
+{
+  bench::Report report ("svg_load");
+  init_core ();
+  init_base ();
+  init_display ();
+  init_gui ();
+  for (int n : { 10, 100, 1000, 10000 }) {
+    std::string path = generate (n);
+    long iter = std::max (3, 10000 / n);
+    report.add ("load + delete", n, bench::ns_per_op (iter, [&] () {
+      Process* p = XML::djnLoadFromXML (path);
+      delete p;
+    }) / 1000, "us");
+    report.add ("load + delete in arena", n, bench::ns_per_op (iter, [&] () {
+      Arena arena;
+      Process* p = XML::djnLoadFromXML (path, &arena);
+      delete p;
+    }) / 1000, "us");
+    remove (path.c_str ());
+  }
+  return 0;
+}
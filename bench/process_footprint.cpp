@@ -0,0 +1,94 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+/* heap bytes and construction time per DoubleProperty, named and anonymous;
+ * the named ones include their share of the parent's list of children */
+
+#include "core/core.h"
+#include "core/core-dev.h"
+#include "core/utils-dev.h"
+
+#include "bench.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long> nb_bytes (0);
+
+void*
+operator new (size_t size)
+{
+  nb_bytes += size;
+  void* p = malloc (size);
+  if (p == nullptr)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void* p) noexcept
+{
+  free (p);
+}
+
+void
+operator delete (void* p, size_t) noexcept
+{
+  free (p);
+}
+
+using namespace djnn;
+
+static void
+measure (bench::Report& report, const std::string& label, bool named, bool with_location)
+{
+  const int nb = 100000;
+  Component* root = new Component (nullptr, "root");
+  std::vector<Process*> props;
+  props.reserve (nb);
+  if (with_location)
+    Context::instance ()->new_line (42, "bench/process_footprint.sma");
+  long before = nb_bytes;
+  struct timespec start;
+  get_monotonic_time (&start);
+  for (int i = 0; i < nb; i++) {
+    Process* p = named ? new DoubleProperty (root, "x", 0) : new DoubleProperty (0);
+    props.push_back (p);
+  }
+  double ms = elapsed_ms (start);
+  long bytes = nb_bytes - before;
+  Context::instance ()->new_line (-1, "");
+  /* the nodes themselves come from the pools, not from operator new */
+  bytes += (long) node_footprint (sizeof (DoubleProperty)) * nb;
+  report.add ("bytes " + label, -1, (double) bytes / nb, "bytes");
+  report.add ("construction " + label, -1, ms * 1e6 / nb, "ns");
+  /* the named ones are deleted with their parent */
+  if (!named)
+    for (auto p : props)
+      delete p;
+  delete root;
+}
+
+int
+main ()
+{
+  bench::Report report ("process_footprint");
+  init_core ();
+  report.add ("sizeof (DoubleProperty)", -1, sizeof (DoubleProperty), "bytes");
+  measure (report, "anonymous", false, false);
+  measure (report, "named", true, false);
+  measure (report, "named with debug info", true, true);
+  return 0;
+}
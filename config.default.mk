@@ -1,3 +1,4 @@
 build_dir := build
 graphics := QT
+#graphics := SOFT # offscreen, no windowing system
 
@@ -0,0 +1,3 @@
+build_dir := build
+graphics := QT
+
@@ -18,111 +18,103 @@
 #include "../core/tree/int_property.h"
 #include "../core/execution/graph.h"
 #include "../core/serializer/serializer.h"
-#include "../core/utils-dev.h"
-#include <sys/time.h>
-#include <boost/chrono.hpp>
-#include <boost/thread/thread.hpp>
 
-//#include <QThread.h>
+#include <algorithm>
 #include <iostream>
 
 #define DBG std::cerr << __FILE__ ":" << __LINE__ << ":" << __FUNCTION__ << std::endl;
 
 namespace djnn
 {
-  Clock::Clock (std::chrono::milliseconds period)
+  void
+  Clock::init_clock (int period)
   {
-    _period = new IntProperty (this, "period", period.count ());
+    _period = new IntProperty (this, "period", period);
+    _missed_tick_policy = new IntProperty (this, "missed_tick_policy", CLOCK_SKIP);
+    _overruns = new IntProperty (this, "overruns", 0);
     _elapsed = new DoubleProperty (this, "elapsed", 0);
+    _jitter = new DoubleProperty (this, "jitter", 0);
     _tick = new Spike (this, "tick");
   }
 
+  Clock::Clock (std::chrono::milliseconds period)
+  {
+    init_clock (period.count ());
+  }
+
   Clock::Clock (Process *p, const std::string& n, std::chrono::milliseconds period) :
       Process (p, n)
   {
-    _period = new IntProperty (this, "period", period.count ());
-    _elapsed = new DoubleProperty (this, "elapsed", 0);
-    _tick = new Spike (this, "tick");
+    init_clock (period.count ());
     Process::finalize ();
   }
 
   Clock::Clock (int period)
   {
-    _period = new IntProperty (this, "period", period);
-    _elapsed = new DoubleProperty (this, "elapsed", 0);
-    _tick = new Spike (this, "tick");
+    init_clock (period);
   }
 
   Clock::Clock (Process *p, const std::string& n, int period) :
       Process (p, n)
   {
-    _period = new IntProperty (this, "period", period);
-    _elapsed = new DoubleProperty (this, "elapsed", 0);
-    _tick = new Spike (this, "tick");
+    init_clock (period);
     Process::finalize ();
   }
 
   Clock::~Clock ()
   {
+    TimerService::instance ().cancel (this);
     if (_tick) { delete _tick; _tick = nullptr;}
+    if (_jitter) { delete _jitter; _jitter = nullptr;}
     if (_elapsed) { delete _elapsed; _elapsed = nullptr;}
+    if (_overruns) { delete _overruns; _overruns = nullptr;}
+    if (_missed_tick_policy) { delete _missed_tick_policy; _missed_tick_policy = nullptr;}
     if (_period) { delete _period; _period = nullptr;}
   }
 
   void
   Clock::activate ()
   {
-    //djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
-    //set_please_stop (true);
-    //if ( _thread.joinable() ) _thread.join();
-    //DBG;
-    please_stop();
-    start_thread();
-
-    //djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
+    _last_tick = timer_clock_t::now ();
+    TimerService::instance ().schedule (this, _last_tick + std::chrono::milliseconds (_period->get_value ()));
   }
 
   void
   Clock::deactivate ()
   {
-    please_stop ();
+    TimerService::instance ().cancel (this);
   }
 
+  /* beyond this many late periods, a bursting clock coalesces the rest */
+  static const int max_burst = 10;
+
   void
-  Clock::run ()
+  Clock::do_timer ()
   {
-//    QThread::currentThread()->setPriority(QThread::TimeCriticalPriority);
-    struct timespec before;
-    struct timespec after;
-    set_please_stop (false);
-    try {
-      //std::cerr << this << " >> run" << std::endl;
-      while (!get_please_stop ()) {
-        //std
-        boost
-        ::chrono::milliseconds duration (_period->get_value ());
-        //std::cerr << this << "  >> sleep " << duration.count() << std::endl;
-        //std
-        get_monotonic_time(&before);
-        boost
-        ::this_thread::sleep_for (duration); // blocking call
-        //std::cerr << this << "  << sleep end" << std::endl;
-        djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
-        //std::cerr << this << "  ** sleep GOT" << std::endl;
-        if (!get_please_stop ()) {
-          get_monotonic_time(&after);
-          double elapsedTime = (after.tv_sec * 1000 + after.tv_nsec * 1e-6) - (before.tv_sec * 1000 + before.tv_nsec * 1e-6);
-          _elapsed->set_value (elapsedTime, true);
-          _tick->activation (); // propagating
-          GRAPH_EXEC; // executing
-        }
-        djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
-      }
-      //std::cerr << this << " << stop" << std::endl;
-
-    } catch (exception& e) {
-      std::cerr << e.what() << std::endl;
+    timer_date_t now = timer_clock_t::now ();
+    timer_date_t due = deadline ();
+    std::chrono::milliseconds period (std::max (_period->get_value (), 1));
+    /* the deadlines are absolute, so that the ticks do not drift */
+    int missed = (now - due) / period;
+    timer_date_t next;
+    switch (_missed_tick_policy->get_value ()) {
+      case CLOCK_BURST:
+        next = missed < max_burst ? due + period : due + (missed + 1) * period;
+        break;
+      case CLOCK_COALESCE:
+        next = due + (missed + 1) * period;
+        break;
+      default:
+        next = missed > 0 ? now + period : due + period;
     }
+    TimerService::instance ().schedule (this, next); // before ticking, which may stop the clock
+    double elapsed = std::chrono::duration<double, std::milli> (now - _last_tick).count ();
+    _last_tick = now;
+    if (missed > 0)
+      _overruns->set_value (_overruns->get_value () + 1, true);
+    _jitter->set_value (std::chrono::duration<double, std::milli> (now - due).count (), true);
+    _elapsed->set_value (elapsed, true);
+    _tick->activation (); // propagating, executed by the timer service
   }
 
   void
@@ -131,7 +123,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:clock");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("period", _period->get_value ());
     AbstractSerializer::serializer->end ();
 
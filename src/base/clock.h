@@ -16,14 +16,21 @@
 #pragma once
 
 #include "../core/tree/process.h"
-#include "../core/syshook/external_source.h"
+#include "../core/syshook/timer_service.h"
 
 #include <chrono>
 
 namespace djnn
 {
 
-  class Clock : public Process, public ExternalSource
+  /* what a clock does with the ticks it is too late for */
+  enum {
+    CLOCK_SKIP,     // drop them and restart the period from now
+    CLOCK_COALESCE, // deliver a single tick and stay on the initial period grid
+    CLOCK_BURST     // deliver them all as fast as possible, up to a limit
+  };
+
+  class Clock : public Process, public TimerClient
   {
   public:
     Clock (Process* p, const std::string& n, std::chrono::milliseconds period = 1000ms);
@@ -40,10 +47,16 @@ namespace djnn
 
   private:
     IntProperty *_period;
+    IntProperty *_missed_tick_policy;
+    IntProperty *_overruns;
     DoubleProperty *_elapsed;
+    DoubleProperty *_jitter;
     Process *_tick;
+    timer_date_t _last_tick;
+
+    void init_clock (int period);
 
-    void run() override;
+    void do_timer () override;
   };
 
 }
@@ -29,7 +29,7 @@ namespace djnn
   Connector::ConnectorAction::activate () { 
     /* do we have to check if the source is activable? */
     if (_parent->get_state () < deactivating)
-      AbstractAssignment::do_assignment (_src, _dst, _propagate);   
+      _assign (_src, _dst, _propagate);
   }
 
   Connector::Connector (Process *p, string n, Process *src, string ispec, Process *dst,
@@ -90,7 +90,7 @@ namespace djnn
     if (!_dst)
       warning (this, "invalid destination (not a Property) in connector (" + get_name() + "," + ispec + ", " + dspec + ")");
   
-    _action = new ConnectorAction (this, "connector_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, true);
+    _action = new ConnectorAction (this, "action", _src, _dst, true);
     _c_src = new Coupling (_src, ACTIVATION, _action, ACTIVATION);
 
     Graph::instance ().add_edge (_src, _dst);
@@ -117,7 +117,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("base:connector");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("source", buf);
     buf.clear ();
@@ -186,7 +186,7 @@ namespace djnn
       warning (this, "invalid source or destination in pausedconnector (" + get_name() + "," + ispec + " " + dspec + ")");
     }
 
-    _action = new Connector::ConnectorAction (this, "pausedconnector_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, false);
+    _action = new Connector::ConnectorAction (this, "action", _src, _dst, false);
     _c_src = new Coupling (_src, ACTIVATION, _action, ACTIVATION);
     
     Graph::instance ().add_edge (_src, _dst);
@@ -214,7 +214,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("base:pausedconnector");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("source", buf);
     buf.clear ();
@@ -34,7 +34,7 @@ namespace djnn {
     {
     public:
       ConnectorAction (Process* p, const string &n, AbstractProperty* src, AbstractProperty* dst, bool propagate) :
-	Process (p, n), _src (src), _dst (dst), _propagate (propagate) {};
+	Process (p, n), _src (src), _dst (dst), _assign (AbstractAssignment::get_assignment_proc (src, dst)), _propagate (propagate) {};
       virtual ~ConnectorAction () {};
       void activate () override;
       void deactivate () override {};
@@ -42,6 +42,7 @@ namespace djnn {
     private:
       AbstractProperty* _src;
       AbstractProperty* _dst;
+      assignment_proc_t _assign;
       bool _propagate;
     };
 
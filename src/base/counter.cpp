@@ -31,14 +31,14 @@ namespace djnn
     _delta = new DoubleProperty (this, "delta", delta);
 
     /* reset action */
-    _action_reset = new CounterResetAction (this, n + "_action_reset", &_reset_occurred);
+    _action_reset = new CounterResetAction (this, "action_reset", &_reset_occurred);
     _c_reset = new Coupling (_reset, ACTIVATION, _action_reset, ACTIVATION);
     _c_reset->disable ();
     Graph::instance ().add_edge (_reset, _action_reset);
     Graph::instance ().add_edge (_action_reset, _output);
 
     /* step action */    
-    _action_step = new CounterStepAction (this, n + "_action_step", _init, _delta, _output, &_reset_occurred);
+    _action_step = new CounterStepAction (this, "action_step", _init, _delta, _output, &_reset_occurred);
     _c_step = new Coupling (_step, ACTIVATION, _action_step, ACTIVATION);
     _c_step->disable ();
     Graph::instance ().add_edge (_step, _action_step);
@@ -92,7 +92,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:counter");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->float_attribute ("init", _init->get_value ());
     AbstractSerializer::serializer->float_attribute ("delta", _delta->get_value ());
     AbstractSerializer::serializer->end ();
@@ -64,7 +64,7 @@ namespace djnn
       t->activation ();
     }
     Container::activate ();
-    _parent_fsm->update_state (this, _name);
+    _parent_fsm->update_state (this, get_name ());
   }
 
   void
@@ -88,7 +88,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:fsmstate");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     for (auto c : _children)
         c->serialize (type);
@@ -132,7 +132,7 @@ namespace djnn
     else
       _action = 0;
 
-    _fsm_action = new FSMTransitionAction (this, "transition_action_" + _src->get_name () + "_" + _dst->get_name (), _src, _dst, _action);
+    _fsm_action = new FSMTransitionAction (this, "transition_action", _src, _dst, _action);
     _c_src = new Coupling (_trigger, ACTIVATION, _fsm_action, ACTIVATION);
     Graph::instance ().add_edge (_trigger, _fsm_action);
     Graph::instance ().add_edge (_fsm_action, p->find_component ("state"));
@@ -174,7 +174,7 @@ namespace djnn
       return;
     }
   
-    _fsm_action = new FSMTransitionAction (this, "transition_action_" + _src->get_name () + "_" + _dst->get_name (), _src, _dst, _action);
+    _fsm_action = new FSMTransitionAction (this, "transition_action", _src, _dst, _action);
     _c_src = new Coupling (_trigger, ACTIVATION, _fsm_action, ACTIVATION);
     Graph::instance ().add_edge (_trigger, _fsm_action);
     Graph::instance ().add_edge (_fsm_action, p->find_component ("state"));
@@ -238,7 +238,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:fsmtransition");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("from", buf);
@@ -324,7 +324,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:fsm");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     for (auto st : _states)
         st->serialize (type);
@@ -128,7 +128,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:hermitecurve");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->float_attribute ("p1", dynamic_cast<DoubleProperty*> (_p1)->get_value ());
     AbstractSerializer::serializer->float_attribute ("p2", dynamic_cast<DoubleProperty*> (_p2)->get_value ());
     AbstractSerializer::serializer->float_attribute ("t1", dynamic_cast<DoubleProperty*> (_t1)->get_value ());
@@ -33,7 +33,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:exp");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
    
     AbstractSerializer::serializer->end ();
@@ -57,7 +57,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:log");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
    
     AbstractSerializer::serializer->end ();
@@ -81,7 +81,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:log10");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
    
     AbstractSerializer::serializer->end ();
@@ -106,7 +106,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:pow");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("base", dynamic_cast<DoubleProperty*> (_left)->get_value ());
     AbstractSerializer::serializer->int_attribute ("exponent", dynamic_cast<DoubleProperty*> (_right)->get_value ());
    
@@ -131,7 +131,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:sqrt");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
    
     AbstractSerializer::serializer->end ();
@@ -155,7 +155,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:abs");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
    
     AbstractSerializer::serializer->end ();
@@ -180,7 +180,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:min");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("min", dynamic_cast<DoubleProperty*> (_left)->get_value ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_right)->get_value ());
 
@@ -206,7 +206,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:max");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("max", dynamic_cast<DoubleProperty*> (_left)->get_value ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_right)->get_value ());
 
@@ -261,7 +261,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:boundedvalue");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("min", dynamic_cast<DoubleProperty*> (_min)->get_value ());
     AbstractSerializer::serializer->int_attribute ("max", dynamic_cast<DoubleProperty*> (_max)->get_value ());
     AbstractSerializer::serializer->int_attribute ("input", dynamic_cast<DoubleProperty*> (_input)->get_value ());
@@ -31,12 +31,14 @@ namespace djnn {
     Process* r_val;
   } init_val;
 
+  /* the actions of the operators only read their operands and set their
+   * result: they run on the graph worker threads (see Process::set_thread_safe) */
   class BinaryOperatorAction : public Process
   {
   public:
     BinaryOperatorAction (Process* parent, const string &name, AbstractProperty* left, AbstractProperty* right,
                           AbstractProperty* result) :
-    Process (parent, name), _left (left), _right (right), _result (result) {}
+    Process (parent, name), _left (left), _right (right), _result (result) { set_thread_safe (true); }
     virtual ~BinaryOperatorAction () {};
   protected:
     AbstractProperty* _left;
@@ -62,7 +64,7 @@ namespace djnn {
   {
   public:
     UnaryOperatorAction (Process* parent, const string &name, AbstractProperty* input, AbstractProperty* output) :
-    Process (parent, name), _input (input), _output (output){}
+    Process (parent, name), _input (input), _output (output) { set_thread_safe (true); }
     virtual ~UnaryOperatorAction () {};
   protected:
     AbstractProperty* _input;
@@ -24,7 +24,7 @@ namespace djnn
   TextPrinter::init ()
   {
     _input = new TextProperty (this, "input", "");
-    _action = new TextPrinterAction (this, get_name () + "_action", _input);
+    _action = new TextPrinterAction (this, "action", _input);
     c_input = new Coupling (_input, ACTIVATION, _action, ACTIVATION);
     c_input->disable ();
     Graph::instance ().add_edge (_input, _action);
@@ -67,7 +67,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:textprinter");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
    
     AbstractSerializer::serializer->end ();
 
@@ -80,7 +80,7 @@ namespace djnn
     _left = new TextProperty (this, "head", "");
     _right = new TextProperty (this, "tail", "");
     _result = new TextProperty (this, "output", "");
-    init_couplings (new TextCatenatorAction (this, n + "_action", _left, _right, _result));
+    init_couplings (new TextCatenatorAction (this, "action", _left, _right, _result));
     Process::finalize ();
   }
 
@@ -90,7 +90,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:textcatenator");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
    
     AbstractSerializer::serializer->end ();
 
@@ -103,7 +103,7 @@ namespace djnn
     _left = new TextProperty (this, "left", left);
     _right = new TextProperty (this, "right", right);
     _result = new BoolProperty (this, "output", left.compare (right) == 0);
-    init_couplings (new TextComparatorAction (this, n + "_action", _left, _right, _result));
+    init_couplings (new TextComparatorAction (this, "action", _left, _right, _result));
     Process::finalize ();
   }
 
@@ -113,7 +113,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:textcomparator");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->text_attribute ("left", dynamic_cast<TextProperty*> (_left)->get_value ());
     AbstractSerializer::serializer->text_attribute ("right", dynamic_cast<TextProperty*> (_right)->get_value ());
     
@@ -191,7 +191,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("base:doubleformatter");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->float_attribute ("initial", dynamic_cast<DoubleProperty*> (_input)->get_value ());
     AbstractSerializer::serializer->int_attribute ("decimal", dynamic_cast<IntProperty*> (_decimal)->get_value ());
     
@@ -263,7 +263,7 @@ namespace djnn
     AbstractSerializer::pre_serialize (this, type);
 
     AbstractSerializer::serializer->start ("base:text-accumulator");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->text_attribute ("initial", _state->get_value ());
 
     AbstractSerializer::serializer->end ();
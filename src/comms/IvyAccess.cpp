@@ -183,6 +183,7 @@ namespace djnn
   const std::string& bus, const std::string& appname, const std::string& ready, bool isModel) :
  Process (p, n, isModel)
  {
+  set_main_thread_only ();
   _bus =  bus;
   _appname =  appname;
   _ready_message = ready;
@@ -228,18 +229,20 @@ IvyAccess::~IvyAccess ()
 }
 
 void IvyAccess::set_arriving(string v) {
-  _arriving->set_value (v, true);
-
   djnn::get_exclusive_access (DBG_GET);
-  GRAPH_EXEC;
+  {
+    GraphUpdate update;
+    _arriving->set_value (v, true);
+  }
   djnn::release_exclusive_access (DBG_REL);
 }
 
 void IvyAccess::set_leaving(string v) {
-  _leaving->set_value (v, true);
-
   djnn::get_exclusive_access (DBG_GET);
-  GRAPH_EXEC;
+  {
+    GraphUpdate update;
+    _leaving->set_value (v, true);
+  }
   djnn::release_exclusive_access (DBG_REL);
 }
 
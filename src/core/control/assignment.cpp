@@ -25,6 +25,7 @@
 #include "../serializer/serializer.h"
 
 #include <iostream>
+#include <typeinfo>
 
 namespace djnn
 {
@@ -127,12 +128,57 @@ namespace djnn
       }
   }
 
+  /* the qualified call to D::set_value is not virtual */
+  template <typename S, typename D>
+  static void
+  assign (AbstractProperty* src, AbstractProperty* dst, bool propagate)
+  {
+    static_cast<D*> (dst)->D::set_value (static_cast<S*> (src)->get_value (), propagate);
+  }
+
+  template <typename S>
+  static assignment_proc_t
+  get_proc_from (AbstractProperty* dst)
+  {
+    const std::type_info& t = typeid (*dst);
+    if (t == typeid (DoubleProperty))
+      return &assign<S, DoubleProperty>;
+    if (t == typeid (IntProperty))
+      return &assign<S, IntProperty>;
+    if (t == typeid (BoolProperty))
+      return &assign<S, BoolProperty>;
+    if (t == typeid (TextProperty))
+      return &assign<S, TextProperty>;
+    if (t == typeid (RefProperty))
+      return &assign<S, RefProperty>;
+    return &AbstractAssignment::do_assignment;
+  }
+
+  assignment_proc_t
+  AbstractAssignment::get_assignment_proc (AbstractProperty* src, AbstractProperty* dst)
+  {
+    if (src == nullptr || dst == nullptr)
+      return &AbstractAssignment::do_assignment;
+    const std::type_info& t = typeid (*src);
+    if (t == typeid (DoubleProperty))
+      return get_proc_from<DoubleProperty> (dst);
+    if (t == typeid (IntProperty))
+      return get_proc_from<IntProperty> (dst);
+    if (t == typeid (BoolProperty))
+      return get_proc_from<BoolProperty> (dst);
+    if (t == typeid (TextProperty))
+      return get_proc_from<TextProperty> (dst);
+    if (t == typeid (RefProperty))
+      return get_proc_from<RefProperty> (dst);
+    return &AbstractAssignment::do_assignment;
+  }
+
   Assignment::Assignment (Process* src, const string &ispec, Process* dst, const string &dspec,
                           bool isModel) : 
       AbstractAssignment (src, ispec, dst, dspec, isModel)
   {
     _model = isModel;
-    _action = new AssignmentAction (this, "assignment_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, true);
+    _action = new AssignmentAction (this, "action", _src, _dst, true);
     Graph::instance ().add_edge (_src, _dst);
   }
 
@@ -141,7 +187,7 @@ namespace djnn
       AbstractAssignment (parent, name, src, ispec, dst, dspec, isModel)
   {
     _model = isModel;
-    _action = new AssignmentAction (this, "assignment_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, true);
+    _action = new AssignmentAction (this, "action", _src, _dst, true);
     Graph::instance ().add_edge (_src, _dst);
     if (_parent && _parent->state_dependency () != nullptr)
       Graph::instance ().add_edge (_parent->state_dependency (), _dst);
@@ -176,7 +222,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:assignment");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("source", buf);
     buf.clear ();
@@ -194,7 +240,7 @@ namespace djnn
     AbstractAssignment (src, ispec, dst, dspec, isModel)
   {
     _model = isModel;
-    _action = new AssignmentAction (this, "pausedAssignment_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, false);
+    _action = new AssignmentAction (this, "action", _src, _dst, false);
     Graph::instance ().add_edge (_src, _dst);
   }
 
@@ -203,7 +249,7 @@ namespace djnn
       AbstractAssignment (parent, name, src, ispec, dst, dspec, isModel)
   {
     _model = isModel;
-    _action = new AssignmentAction (this, "pausedAssignment_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src, _dst, false);
+    _action = new AssignmentAction (this, "action", _src, _dst, false);
     Graph::instance ().add_edge (_src, _dst);
     if (_parent && _parent->state_dependency () != nullptr)
       Graph::instance ().add_edge (_parent->state_dependency (), _dst);
@@ -238,7 +284,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:pausedassignment");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("source", buf);
     buf.clear ();
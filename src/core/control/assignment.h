@@ -21,6 +21,9 @@
 namespace djnn {
 
 
+  /* copies the value of src into dst, for a given pair of property types */
+  typedef void (*assignment_proc_t) (AbstractProperty* src, AbstractProperty* dst, bool propagate);
+
   class AbstractAssignment : public Process {
 
    friend class Assignment;
@@ -30,14 +33,16 @@ namespace djnn {
    class AssignmentAction : public Process
    {
    public:
-    AssignmentAction (Process* p, const string &n, AbstractProperty* src, AbstractProperty* dst, bool propagate) : Process (p, n), _src (src), _dst (dst), _propagate (propagate) {}
+    AssignmentAction (Process* p, const string &n, AbstractProperty* src, AbstractProperty* dst, bool propagate) :
+      Process (p, n), _src (src), _dst (dst), _assign (AbstractAssignment::get_assignment_proc (src, dst)), _propagate (propagate) {}
     virtual ~AssignmentAction () {}
-    void activate () override { AbstractAssignment::do_assignment(_src, _dst, _propagate); };
+    void activate () override { _assign (_src, _dst, _propagate); };
     void deactivate () override {}
     void exec (int flag) override { activate (); }
   private:
     AbstractProperty* _src;
     AbstractProperty* _dst;
+    assignment_proc_t _assign;
     bool _propagate;
   };
 
@@ -45,6 +50,9 @@ namespace djnn {
     AbstractAssignment (Process* src, const string &ispec, Process* dst, const string &dspec, bool isModel);
     AbstractAssignment (Process* p, const string &n, Process* src, const string &ispec, Process* dst, const string &dspec, bool isModel);
     static void do_assignment (AbstractProperty* src, AbstractProperty* dst, bool propagate);
+    /* the copy specialized for the exact types of src and dst, with neither RTTI
+     * nor virtual dispatch; do_assignment when they are not core properties */
+    static assignment_proc_t get_assignment_proc (AbstractProperty* src, AbstractProperty* dst);
   protected:
     AbstractProperty* _src;
     AbstractProperty* _dst;
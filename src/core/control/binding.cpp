@@ -47,7 +47,7 @@ namespace djnn
       }
     } else
       _dst = dst;
-    _action = new BindingAction (this, "binding_" + _src->get_name () + "_to_" + _dst->get_name () + "_action", _src,
+    _action = new BindingAction (this, "action", _src,
                                           _dst);
     _c_src = new Coupling (_src, ACTIVATION, _action, ACTIVATION);
     Graph::instance ().add_edge (_src, _dst);
@@ -89,7 +89,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:binding");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _src, buf);
     AbstractSerializer::serializer->text_attribute ("source", buf);
     buf.clear ();
@@ -15,6 +15,7 @@
 #pragma once
 #include <iostream>
 #include <memory>
+#include "../tree/node_pool.h"
 
 
 namespace djnn {
@@ -26,6 +27,8 @@ namespace djnn {
     Coupling (Process* src, int src_flag, Process* dst, int dst_flag);
     Coupling (Process* src, int src_flag, Process* dst, int dst_flag, Process* data);
     virtual ~Coupling();
+    static void* operator new (size_t size) { return alloc_node (size); }
+    static void operator delete (void* p, size_t size) { free_node (p, size); }
     void init_coupling (Process* src, int src_flag, Process* dst, int dst_flag);
     void set_data (Process* data) { _data = data; }
     void propagateActivation ();
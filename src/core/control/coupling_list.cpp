@@ -0,0 +1,118 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "coupling_list.h"
+#include "coupling.h"
+
+#include <algorithm>
+
+namespace djnn
+{
+  CouplingList::CouplingList () :
+      _size (0), _capacity (nb_inline), _dispatch_depth (0), _has_tombstones (false)
+  {
+  }
+
+  CouplingList::~CouplingList ()
+  {
+    if (_capacity > nb_inline)
+      delete[] _heap;
+  }
+
+  void
+  CouplingList::add (Coupling* c)
+  {
+    if (_size == _capacity) {
+      Coupling** heap = new Coupling*[_capacity * 2];
+      std::copy (data (), data () + _size, heap);
+      if (_capacity > nb_inline)
+        delete[] _heap;
+      _heap = heap;
+      _capacity *= 2;
+    }
+    data ()[_size++] = c;
+  }
+
+  void
+  CouplingList::remove (Coupling* c)
+  {
+    Coupling** d = data ();
+    if (_dispatch_depth > 0) {
+      for (int i = 0; i < _size; i++) {
+        if (d[i] == c) {
+          d[i] = nullptr;
+          _has_tombstones = true;
+        }
+      }
+    } else
+      _size = std::remove (d, d + _size, c) - d;
+  }
+
+  int
+  CouplingList::size () const
+  {
+    if (!_has_tombstones)
+      return _size;
+    Coupling* const* d = data ();
+    return _size - std::count (d, d + _size, nullptr);
+  }
+
+  void
+  CouplingList::purge ()
+  {
+    Coupling** d = data ();
+    _size = std::remove (d, d + _size, nullptr) - d;
+    _has_tombstones = false;
+  }
+
+  std::vector<Coupling*>
+  CouplingList::to_vector () const
+  {
+    std::vector<Coupling*> v;
+    Coupling* const* d = data ();
+    for (int i = 0; i < _size; i++)
+      if (d[i] != nullptr)
+        v.push_back (d[i]);
+    return v;
+  }
+
+  /* the storage may be reallocated by an add during the loop, hence data () on each step */
+  void
+  CouplingList::propagate_activation ()
+  {
+    int size = _size;
+    _dispatch_depth++;
+    for (int i = 0; i < size; i++) {
+      Coupling* c = data ()[i];
+      if (c != nullptr)
+        c->propagateActivation ();
+    }
+    if (--_dispatch_depth == 0 && _has_tombstones)
+      purge ();
+  }
+
+  void
+  CouplingList::propagate_deactivation ()
+  {
+    int size = _size;
+    _dispatch_depth++;
+    for (int i = 0; i < size; i++) {
+      Coupling* c = data ()[i];
+      if (c != nullptr)
+        c->propagateDeactivation ();
+    }
+    if (--_dispatch_depth == 0 && _has_tombstones)
+      purge ();
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace djnn {
+
+  class Coupling;
+
+  /* List of the couplings of a process, dispatched without copying it.
+   * The first couplings are stored in the object itself, so that the usual
+   * one or two of a property need no allocation. A coupling removed during a
+   * dispatch is replaced by a tombstone (nullptr) and the list is compacted
+   * when the outermost dispatch ends; couplings added during a dispatch are
+   * not visited by it. */
+  class CouplingList {
+  public:
+    CouplingList ();
+    ~CouplingList ();
+    void add (Coupling* c);
+    void remove (Coupling* c);
+    bool empty () const { return size () == 0; }
+    int size () const;
+    std::vector<Coupling*> to_vector () const;
+    void propagate_activation ();
+    void propagate_deactivation ();
+
+  private:
+    CouplingList (const CouplingList&) = delete;
+    CouplingList & operator= (const CouplingList&) = delete;
+    static const int nb_inline = 2;
+    Coupling** data () { return _capacity > nb_inline ? _heap : _inline; }
+    Coupling* const* data () const { return _capacity > nb_inline ? _heap : _inline; }
+    void purge ();
+    union {
+      Coupling* _inline[nb_inline];
+      Coupling** _heap;
+    };
+    int _size, _capacity;
+    unsigned short _dispatch_depth;
+    bool _has_tombstones;
+  };
+}
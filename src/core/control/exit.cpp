@@ -50,7 +50,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:exit");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("value", _value->get_value ());
     AbstractSerializer::serializer->text_attribute ("model", _model ? "true" : "false");
     AbstractSerializer::serializer->end ();
@@ -22,6 +22,9 @@ namespace djnn {
   using namespace std;
 
   typedef void (NativeCode) (Process*);
+  /* a NativeAction runs on the main thread, unless it is declared with
+   * set_thread_safe (true) as running on the graph worker threads, see
+   * Process::set_thread_safe for what its code may then do */
   class NativeAction : public Process
   {
   public:
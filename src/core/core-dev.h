@@ -16,6 +16,7 @@
 #include "core.h"
 
 #include "execution/graph.h"
+#include "execution/profiler.h"
 #include "execution/component_observer.h"
 #include "control/coupling.h"
 #include "syshook/syshook.h"
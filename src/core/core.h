@@ -16,6 +16,8 @@
 #pragma once
 
 #include "tree/process.h"
+#include "tree/node_pool.h"
+#include "tree/path_ref.h"
 #include "control/binding.h"
 #include "control/activator.h"
 #include "tree/component.h"
@@ -28,6 +30,7 @@
 #include "control/exit.h"
 #include "serializer/serializer.h"
 #include "syshook/timer.h"
+#include "syshook/event_queue.h"
 #include "tree/abstract_property.h"
 #include "tree/blank.h"
 #include "tree/bool_property.h"
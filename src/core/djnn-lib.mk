@@ -1,7 +1,9 @@
 lib_ldflags = -lexpat -lcurl -lpthread
 lib_srcs := src/core/syshook/external_source.cpp src/core/syshook/syshook.cpp \
 			src/core/syshook/main_loop.cpp \
-			src/core/syshook/timer.cpp src/core/core.cpp \
+			src/core/syshook/timer.cpp src/core/syshook/timer_service.cpp \
+			src/core/syshook/event_queue.cpp \
+			src/core/core.cpp \
 			src/core/error.cpp src/core/utils-dev.cpp src/core/uri.cpp
 
 lib_srcs += $(shell find src/core/control -name "*.cpp")
@@ -11,7 +13,7 @@ lib_srcs += $(shell find src/core/serializer -name "*.cpp")
 lib_srcs += $(shell find src/core/xml -name "*.cpp")
 
 ifeq ($(os),$(filter $(os),Darwin Linux))
-lib_srcs += src/core/syshook/unix/iofd.cpp
+lib_srcs += src/core/syshook/unix/iofd.cpp src/core/syshook/unix/io_reactor.cpp
 endif
 
 ifeq ($(graphics),QT)
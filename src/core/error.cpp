@@ -14,6 +14,10 @@
 
 #include "error.h"
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace djnn
 {
   Context* Context::_instance = nullptr;
@@ -26,6 +30,45 @@ namespace djnn
     return _instance;
   }
 
+  /* each location is stored once, as a file index and a line number */
+  static std::mutex locations_mutex;
+  static std::vector<std::string> files;
+  static std::unordered_map<std::string, int> file_indices;
+  static std::vector<std::pair<int, int>> locations (1);
+  static std::unordered_map<long long, int> location_indices;
+
+  int
+  Context::location ()
+  {
+    if (_line == -1)
+      return 0;
+    if (_location != -1)
+      return _location;
+    std::lock_guard<std::mutex> lock (locations_mutex);
+    auto fit = file_indices.find (_filename);
+    if (fit == file_indices.end ()) {
+      fit = file_indices.insert (std::make_pair (_filename, (int) files.size ())).first;
+      files.push_back (_filename);
+    }
+    long long key = ((long long) fit->second << 32) | (unsigned int) _line;
+    auto lit = location_indices.find (key);
+    if (lit == location_indices.end ()) {
+      lit = location_indices.insert (std::make_pair (key, (int) locations.size ())).first;
+      locations.push_back (std::make_pair (fit->second, _line));
+    }
+    _location = lit->second;
+    return _location;
+  }
+
+  std::string
+  Context::location_info (int location)
+  {
+    std::lock_guard<std::mutex> lock (locations_mutex);
+    if (location <= 0 || location >= (int) locations.size ())
+      return "non debug info";
+    return std::string ("File: ") + files[locations[location].first] + " line: " + std::to_string (locations[location].second);
+  }
+
   void
   error (Process* p, const std::string &msg)
   {
@@ -25,13 +25,18 @@ namespace djnn
   class Context {
   public:
     static Context* instance ();
-    void new_line (int line, const std::string &filename) { _line = line; _filename = filename; };
+    void new_line (int line, const std::string &filename) { _line = line; _filename = filename; _location = -1; };
     int line () { return _line; }
     const std::string& filename () { return _filename; }
+    /* compact reference to the current file and line, to be given to
+     * location_info; 0 when there is no debug info */
+    int location ();
+    std::string location_info (int location);
   private:
-    Context () : _line (-1), _filename ("") {}
+    Context () : _line (-1), _location (-1), _filename ("") {}
     static Context* _instance;
     int _line;
+    int _location;
     std::string _filename;
   };
 }
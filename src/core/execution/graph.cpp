@@ -13,22 +13,18 @@
  */
 
 #include "graph.h"
+#include "thread_pool.h"
+#include "profiler.h"
+#include "../utils-dev.h"
 #include "../tree/process.h"
 #include "../tree/abstract_property.h"
 
 #include <algorithm>
+#include <climits>
 #include <iostream>
 
 #define DBG std::cerr << __FUNCTION__ << " " << __FILE__ << ":" << __LINE__ << std::endl;
 
-#define _PERF_TEST 0
-#if _PERF_TEST
-#include "../utils-dev.h"
-static int graph_counter = 0;
-static double graph_total = 0.0;
-static double graph_average = 0.0;
-#endif
-
 namespace djnn
 {
   Graph* Graph::_instance;
@@ -36,6 +32,10 @@ namespace djnn
 
   static std::mutex graph_mutex;
 
+  /* couplings to propagate once the current parallel wave is done, per vertex */
+  typedef std::vector<std::pair<Process*, int> > propagations_t;
+  static thread_local propagations_t* deferred_propagations = nullptr;
+
   enum
   {
     NOT_MARKED, BROWSING, MARKED
@@ -47,38 +47,23 @@ namespace djnn
     return (v1->get_end_date () > v2->get_end_date ());
   }
 
-  Vertex::Vertex (Process* c) :
-      _vertex (c), _mark (NOT_MARKED), _start_date (0), _end_date (0), _count_egdes_in(0), _is_invalid (false)
+  /* heap order of the activation queue: the first vertex in the graph order on top */
+  static bool
+  later_in_order (Vertex* v1, Vertex *v2)
   {
+    return (v1->get_position () > v2->get_position ());
   }
 
-  void
-  Vertex::add_edge (Vertex *dst) 
-  { 
-    //TODO: does push_back check the doubles.
-    _edges.push_back (dst);
-    dst->_count_egdes_in++;
-  }
-
-  void
-  Vertex::remove_edge (Vertex *dst)
+  Vertex::Vertex (Process* c) :
+      _vertex (c), _mark (NOT_MARKED), _start_date (0), _end_date (0), _position (-1), _level (0), _is_invalid (false), _is_process_deleted (false), _is_scheduled (false)
   {
-    Vertex::vertices_t::iterator newend = _edges.end ();
-
-    //remove
-    newend = std::remove (_edges.begin (), _edges.end (), dst);
-
-    //check if end has changed and erase
-    if (newend != _edges.end ()){
-      _edges.erase(newend, _edges.end ());
-      dst->_count_egdes_in--;
-    }
+    _is_property = dynamic_cast<AbstractProperty*> (c) != nullptr;
   }
 
   void
   Vertex::print_vertex () const
   {
-    std::cout << "vertex (" << _vertex->get_name () << ") - " << _count_egdes_in << ", " << _edges.size () << " :\t";
+    std::cout << "vertex (" << _vertex->get_name () << ") - " << _in_edges.size () << ", " << _edges.size () << " :\t";
     if( _edges.size () == 0)
       cout << "EMPTY" << endl;
     else {
@@ -90,34 +75,137 @@ namespace djnn
   }
 
   Graph::Graph () :
-      _cur_date (0), _sorted (false)
+      _pool (nullptr), _reclaimed_bytes (0), _reclaimed_vertices (0), _cur_date (0), _nb_holes (0), _exec_depth (0), _update_depth (0),
+      _sorted (false), _full_sort_needed (false), _levels_dirty (true), _in_parallel_wave (false),
+      _ordering_mode (INCREMENTAL_SORT), _scheduling_mode (SCAN_SCHEDULING)
   {
   }
 
   Graph::~Graph ()
   {
     clear ();
+    delete _pool;
   }
 
   Vertex*
   Graph::get_vertex (Process* c)
   {
-    for (auto v : _vertices) {
-      if (v->get_process  () == c)
-        return (v);
-    }
-    return nullptr;
+    return c->vertex ();
   }
 
   Vertex*
   Graph::add_vertex (Process* c)
   {
     Vertex* v = new Vertex (c);
-    _vertices.push_back (v);
-    _sorted = false;
+    insert_vertex (v);
     return (v);
   }
 
+  void
+  Graph::insert_vertex (Vertex* v)
+  {
+    /* a vertex without edges fits anywhere in the order: put it at the end */
+    v->set_position (_ordered_vertices.size ());
+    _ordered_vertices.push_back (v);
+    if (_ordering_mode == FULL_SORT)
+      _sorted = false;
+    /* the flag may have been set before the process entered the graph */
+    if (v->get_process ()->get_activation_flag () != NONE)
+      schedule_activation (v);
+  }
+
+  /* called when the process goes away or the vertex loses its last edge:
+   * the vertex is no longer executed and will be freed by the next reclaim () */
+  void
+  Graph::remove_vertex (Vertex* v)
+  {
+    if (v->is_invalid ())
+      return;
+    v->invalidate ();
+    if (_in_parallel_wave) {
+      std::lock_guard<std::mutex> lock (_queue_mutex);
+      _to_reclaim.push_back (v);
+    } else
+      _to_reclaim.push_back (v);
+    if (_ordering_mode == FULL_SORT)
+      _sorted = false;
+  }
+
+  void
+  Graph::discard_if_isolated (Vertex* v)
+  {
+    if (v->is_invalid () || !v->_edges.empty () || !v->_in_edges.empty ())
+      return;
+    v->get_process ()->set_vertex (nullptr);
+    remove_vertex (v);
+  }
+
+  void
+  Graph::set_scheduling_mode (scheduling_mode_t mode)
+  {
+    if (mode != WORKLIST_SCHEDULING && _pool != nullptr)
+      std::cerr << "Warning: the parallel execution is off until the worklist scheduling comes back\n";
+    _scheduling_mode = mode;
+    for (auto v : _activation_queue)
+      v->set_scheduled (false);
+    _activation_queue.clear ();
+    if (_scheduling_mode == WORKLIST_SCHEDULING) {
+      for (auto v : _ordered_vertices) {
+        if (v != nullptr && !v->is_invalid () && v->get_process ()->get_activation_flag () != NONE)
+          schedule_activation (v);
+      }
+    }
+  }
+
+  void
+  Graph::schedule_activation (Vertex* v)
+  {
+    if (_scheduling_mode != WORKLIST_SCHEDULING)
+      return;
+    /* workers of a parallel wave may activate vertices concurrently */
+    if (_in_parallel_wave) {
+      std::lock_guard<std::mutex> lock (_queue_mutex);
+      push_activation (v);
+    } else
+      push_activation (v);
+  }
+
+  void
+  Graph::push_activation (Vertex* v)
+  {
+    if (v->is_scheduled () || v->get_position () == -1)
+      return;
+    v->set_scheduled (true);
+    _activation_queue.push_back (v);
+    std::push_heap (_activation_queue.begin (), _activation_queue.end (), later_in_order);
+  }
+
+  void
+  Graph::set_parallel_execution (int nb_threads)
+  {
+    delete _pool;
+    _pool = nb_threads > 0 ? new ThreadPool (nb_threads) : nullptr;
+    /* the waves are made of the activated vertices, only known to the worklist */
+    if (_pool != nullptr && _scheduling_mode != WORKLIST_SCHEDULING)
+      set_scheduling_mode (WORKLIST_SCHEDULING);
+    _levels_dirty = true;
+  }
+
+  int
+  Graph::get_parallel_execution () const
+  {
+    return _pool ? _pool->size () : 0;
+  }
+
+  bool
+  Graph::defer_propagation (Process* p, int flag)
+  {
+    if (deferred_propagations == nullptr)
+      return false;
+    deferred_propagations->push_back (std::make_pair (p, flag));
+    return true;
+  }
+
   void
   Graph::add_output_node (Process* c)
   {
@@ -143,6 +231,7 @@ namespace djnn
       [c](Vertex::vertices_t::iterator::value_type v) {return v->get_process  () == c;}
       ),
     _output_nodes.end());
+    _sorted = false;
   }
 
   void
@@ -159,8 +248,20 @@ namespace djnn
       d = add_vertex (dst);
       dst->set_vertex (d);
     }
-    s->add_edge (d);
-    _sorted = false;
+
+    edge_info_t& e = _edges[edge_key_t (s, d)];
+    if (e.count++ > 0)
+      return;
+    e.out_index = s->_edges.size ();
+    e.in_index = d->_in_edges.size ();
+    s->_edges.push_back (d);
+    d->_in_edges.push_back (s);
+    _levels_dirty = true;
+
+    if (_ordering_mode == FULL_SORT)
+      _sorted = false;
+    else if (s->get_position () > d->get_position ())
+      reorder (s, d);
   }
 
   void
@@ -170,19 +271,172 @@ namespace djnn
     Vertex *d = get_vertex (dst);
     if (s == nullptr || d == nullptr)
       return;
-    s->remove_edge (d);
 
-    // remove vertex if no more out_edges and in_edges
-    Vertex::vertices_t::iterator newend = _vertices.end ();
-    if ((s->get_edges ().size () == 0) && (s->get_count_egdes_in () == 0))
-      newend = std::remove (_vertices.begin (), _vertices.end (), s);
-    if ((d->get_edges ().size () == 0) && (d->get_count_egdes_in () == 0))
-      newend = std::remove (_vertices.begin (), newend, d);
+    auto it = _edges.find (edge_key_t (s, d));
+    if (it == _edges.end () || --it->second.count > 0)
+      return;
+    detach_edge (s, d);
+
+    /* removing an edge never breaks a topological order, only isolated
+     * vertices are taken out of the graph */
+    discard_if_isolated (s);
+    if (d != s)
+      discard_if_isolated (d);
+
+    if (_ordering_mode == FULL_SORT)
+      _sorted = false;
+  }
+
+  /* remove the edge from the adjacency vectors of both ends in constant time,
+   * by moving their last element into the freed slot */
+  void
+  Graph::detach_edge (Vertex* src, Vertex* dst)
+  {
+    auto it = _edges.find (edge_key_t (src, dst));
+    if (it == _edges.end ())
+      return;
+    int out_index = it->second.out_index;
+    int in_index = it->second.in_index;
+    _edges.erase (it);
+    _levels_dirty = true;
+
+    Vertex* last = src->_edges.back ();
+    src->_edges[out_index] = last;
+    src->_edges.pop_back ();
+    if (last != dst)
+      _edges[edge_key_t (src, last)].out_index = out_index;
+
+    last = dst->_in_edges.back ();
+    dst->_in_edges[in_index] = last;
+    dst->_in_edges.pop_back ();
+    if (last != src)
+      _edges[edge_key_t (last, dst)].in_index = in_index;
+  }
+
+  /* free the vertices removed since the last call, with their remaining edges,
+   * and return the number of bytes given back */
+  size_t
+  Graph::reclaim ()
+  {
+    size_t node_size = sizeof (std::pair<const edge_key_t, edge_info_t>) + 2 * sizeof (void*);
+    size_t freed = 0;
+    int nb_freed = 0;
+    Vertex::vertices_t deferred;
+
+    /* the list grows while looping as neighbours become isolated */
+    for (size_t i = 0; i < _to_reclaim.size (); i++) {
+      Vertex* v = _to_reclaim[i];
+      if (v->is_scheduled ()) {
+        deferred.push_back (v);
+        continue;
+      }
+      freed += sizeof (Vertex) + (v->_edges.capacity () + v->_in_edges.capacity ()) * sizeof (Vertex*);
+      freed += (v->_edges.size () + v->_in_edges.size ()) * node_size;
+      while (!v->_edges.empty ()) {
+        Vertex* w = v->_edges.back ();
+        detach_edge (v, w);
+        discard_if_isolated (w);
+      }
+      while (!v->_in_edges.empty ()) {
+        Vertex* w = v->_in_edges.back ();
+        detach_edge (w, v);
+        discard_if_isolated (w);
+      }
+      int pos = v->get_position ();
+      if (pos != -1) {
+        /* leave a hole so that the position of the other vertices remains valid */
+        _ordered_vertices[pos] = nullptr;
+        _nb_holes++;
+      }
+      delete v;
+      nb_freed++;
+    }
+    _to_reclaim.swap (deferred);
+
+    if (_nb_holes > 0 && _exec_depth == 0) {
+      size_t capacity = _ordered_vertices.capacity ();
+      compact ();
+      _ordered_vertices.shrink_to_fit ();
+      freed += (capacity - _ordered_vertices.capacity ()) * sizeof (Vertex*);
+    }
 
-    // erase only once 
-    if (newend != _vertices.end ())
-      _vertices.erase(newend, _vertices.end ());
+    _reclaimed_bytes += freed;
+    _reclaimed_vertices += nb_freed;
+    return freed;
+  }
 
+  /* Pearce-Kelly: the new edge src -> dst goes backward in the current order.
+   * Only the vertices placed between dst and src may have to move: those reachable
+   * from dst (forward) must end up after those reaching src (backward). They are
+   * reassigned to the same set of positions, the rest of the order is untouched. */
+  void
+  Graph::reorder (Vertex* src, Vertex* dst)
+  {
+    int lb = dst->get_position ();
+    int ub = src->get_position ();
+    Vertex::vertices_t forward, backward, stack;
+
+    dst->set_mark (MARKED);
+    forward.push_back (dst);
+    stack.push_back (dst);
+    while (!stack.empty ()) {
+      Vertex* v = stack.back ();
+      stack.pop_back ();
+      for (auto w : v->get_edges ()) {
+        if (w == src) {
+          /* cycle: the incremental order cannot hold, fall back to the full sort */
+          for (auto f : forward)
+            f->set_mark (NOT_MARKED);
+          _full_sort_needed = true;
+          _sorted = false;
+          return;
+        }
+        if (w->get_mark () == NOT_MARKED && w->get_position () < ub) {
+          w->set_mark (MARKED);
+          forward.push_back (w);
+          stack.push_back (w);
+        }
+      }
+    }
+
+    src->set_mark (MARKED);
+    backward.push_back (src);
+    stack.push_back (src);
+    while (!stack.empty ()) {
+      Vertex* v = stack.back ();
+      stack.pop_back ();
+      for (auto w : v->get_in_edges ()) {
+        if (w->get_mark () == NOT_MARKED && w->get_position () > lb) {
+          w->set_mark (MARKED);
+          backward.push_back (w);
+          stack.push_back (w);
+        }
+      }
+    }
+
+    auto by_position = [] (Vertex* v1, Vertex* v2) { return v1->get_position () < v2->get_position (); };
+    std::sort (forward.begin (), forward.end (), by_position);
+    std::sort (backward.begin (), backward.end (), by_position);
+
+    std::vector<int> positions;
+    positions.reserve (forward.size () + backward.size ());
+    for (auto v : backward)
+      positions.push_back (v->get_position ());
+    for (auto v : forward)
+      positions.push_back (v->get_position ());
+    std::sort (positions.begin (), positions.end ());
+
+    int i = 0;
+    for (auto v : backward) {
+      v->set_mark (NOT_MARKED);
+      v->set_position (positions[i]);
+      _ordered_vertices[positions[i++]] = v;
+    }
+    for (auto v : forward) {
+      v->set_mark (NOT_MARKED);
+      v->set_position (positions[i]);
+      _ordered_vertices[positions[i++]] = v;
+    }
     _sorted = false;
   }
 
@@ -190,8 +444,9 @@ namespace djnn
   Graph::print_graph ()
   {
     cout << " --- GRAPH --- " << endl ;
-    for (auto v : _vertices) {
-      v->print_vertex ();
+    for (auto v : _ordered_vertices) {
+      if (v != nullptr && !v->is_invalid ())
+        v->print_vertex ();
     }
     cout << " --- END GRAPH --- " << endl << endl;
   }
@@ -199,11 +454,24 @@ namespace djnn
   void
   Graph::print_sorted ()
   {
-    for (auto v : _sorted_vertices) {
+    for (auto v : get_sorted ()) {
       if (v->get_process ()->get_parent())
         cerr << v->get_process ()->get_parent()->get_name () << "/";
-      cerr << v->get_process  ()->get_name () << " (" << v->get_start_date () << ", " << v->get_end_date () << ")\n";
+      cerr << v->get_process  ()->get_name () << " (" << v->get_position () << ")\n";
+    }
+  }
+
+  Vertex::vertices_t
+  Graph::get_sorted ()
+  {
+    sort ();
+    Vertex::vertices_t sorted;
+    for (auto v : _ordered_vertices) {
+      if (v != nullptr && !v->is_invalid () && !v->is_property ())
+        sorted.push_back (v);
     }
+    sorted.insert (sorted.end (), _output_nodes.begin (), _output_nodes.end ());
+    return sorted;
   }
 
   Graph&
@@ -216,47 +484,98 @@ namespace djnn
     return *(_instance);
   }
 
+  void
+  Graph::set_ordering_mode (ordering_mode_t mode)
+  {
+    _ordering_mode = mode;
+    _full_sort_needed = true;
+    _sorted = false;
+  }
+
   void
   Graph::sort ()
   {
     if (_sorted)
       return;
 
+    if (_ordering_mode == CHECKED_SORT && !_full_sort_needed) {
+      int incremental = check_order ();
+      full_sort ();
+      int full = check_order ();
+      if (incremental > full)
+        cerr << "Warning: incremental graph order breaks " << incremental << " edges, full sort breaks " << full << endl;
+    } else if (_ordering_mode == FULL_SORT || _full_sort_needed) {
+      full_sort ();
+    } else if (_nb_holes > (int) _ordered_vertices.size () / 2) {
+      compact ();
+    }
+    /* positions may have changed: restore the heap order of the pending activations */
+    std::make_heap (_activation_queue.begin (), _activation_queue.end (), later_in_order);
+    _sorted = true;
+  }
+
+  void
+  Graph::full_sort ()
+  {
+    Vertex::vertices_t vertices;
+    vertices.reserve (_ordered_vertices.size () - _nb_holes);
+    for (auto v : _ordered_vertices) {
+      if (v != nullptr)
+        vertices.push_back (v);
+    }
+
     _cur_date = 0;
-    _sorted_vertices.clear ();
+    _ordered_vertices.clear ();
 
     // set every vertex as NOT_MARKED before sorting them
-    for (auto v : _vertices) {
+    for (auto v : vertices) {
       v->set_mark (NOT_MARKED);
     }
 
-    for (auto v : _vertices) {
+    for (auto v : vertices) {
       if (v->get_mark () == NOT_MARKED)
         browse_in_depth (v);
     }
-    std::sort (_sorted_vertices.begin (), _sorted_vertices.end (), sort_vertices);
-    remove_properties ();
-    _sorted_vertices.insert (_sorted_vertices.end (), _output_nodes.begin (), _output_nodes.end ());
-    _sorted = true;
+    std::sort (_ordered_vertices.begin (), _ordered_vertices.end (), sort_vertices);
+
+    /* the incremental ordering starts over from this order */
+    int i = 0;
+    for (auto v : _ordered_vertices) {
+      v->set_position (i++);
+      v->set_mark (NOT_MARKED);
+    }
+    _nb_holes = 0;
+    _full_sort_needed = false;
   }
 
   void
-  Graph::remove_properties ()
-  {
-    /*auto v_it = _sorted_vertices.begin ();
-    while (v_it != _sorted_vertices.end ()) {
-      auto& v = *v_it;
-      AbstractProperty* p = dynamic_cast<AbstractProperty*> (v->get_process  ());
-      if (p != nullptr)
-        v_it = _sorted_vertices.erase (v_it);
-      else
-        ++v_it;
-    }*/
-    _sorted_vertices.erase(
-      std::remove_if (
-        _sorted_vertices.begin (), _sorted_vertices.end (),
-        [](Vertex::vertices_t::iterator::value_type v) { return v->is_invalid () || (dynamic_cast<AbstractProperty*> (v->get_process  ()) != nullptr); }
-      ), _sorted_vertices.end());
+  Graph::compact ()
+  {
+    int i = 0;
+    for (auto v : _ordered_vertices) {
+      if (v == nullptr)
+        continue;
+      v->set_position (i);
+      _ordered_vertices[i++] = v;
+    }
+    _ordered_vertices.resize (i);
+    _nb_holes = 0;
+  }
+
+  /* return the number of edges that go backward in the current order */
+  int
+  Graph::check_order ()
+  {
+    int nb_broken = 0;
+    for (auto v : _ordered_vertices) {
+      if (v == nullptr)
+        continue;
+      for (auto w : v->get_edges ()) {
+        if (v->get_position () >= w->get_position ())
+          nb_broken++;
+      }
+    }
+    return nb_broken;
   }
 
   void
@@ -271,59 +590,253 @@ namespace djnn
     }
     v->set_end_date (++_cur_date);
     v->set_mark (MARKED);
-    _sorted_vertices.push_back (v);
+    _ordered_vertices.push_back (v);
   }
 
   void
   Graph::clear ()
   {
-    _sorted_vertices.clear ();
-    _vertices.clear ();
+    _ordered_vertices.clear ();
+    _edges.clear ();
     _output_nodes.clear ();
+    _activation_queue.clear ();
+    _to_reclaim.clear ();
+    _nb_holes = 0;
   }
 
   void
-  Graph::exec ()
+  Graph::execute (Vertex* v)
   {
+    Process* p = v->get_process ();
+    int action = p->get_activation_flag ();
+    Profiler& profiler = Profiler::instance ();
+    if (profiler.is_enabled () && action != NONE) {
+      /* the entry is made beforehand and outlives the process, which the
+       * action may delete */
+      Profiler::entry_t* e = profiler.enter (p, action);
+      struct timespec start;
+      get_monotonic_time (&start);
+      if (action == ACTIVATION)
+        p->activation ();
+      else
+        p->deactivation ();
+      profiler.record (e, action, elapsed_ms (start));
+    } else {
+      switch (action) {
+        case ACTIVATION:
+          p->activation ();
+          break;
+        case DEACTIVATION:
+          p->deactivation ();
+          break;
+        default:;
+      }
+    }
+    /* the process may have been deleted by its own activation, while a
+     * vertex left isolated by it still has a process to clear */
+    if (!v->is_process_deleted ())
+      p->set_activation_flag (NONE);
+  }
 
-#if _PERF_TEST
-    t1 ();
-#endif
-
-    //graph_mutex.lock ();
-
+  void
+  Graph::exec_sorted ()
+  {
     bool is_end = false;
     while (!is_end) {
       is_end = true;
-      for (auto v : _sorted_vertices) {
+      /* vertices may be added while executing: don't hold any iterator */
+      for (size_t i = 0; i < _ordered_vertices.size (); i++) {
       	if (!_sorted) break;
-        if (v->is_invalid ()) continue;
-        int action = v->get_process  ()->get_activation_flag ();
-        switch (action) {
-          case ACTIVATION:
-            v->get_process  ()->activation ();
-            break;
-          case DEACTIVATION:
-            v->get_process  ()->deactivation ();
-            break;
-          default:;
-        }
-        v->get_process  ()->set_activation_flag (NONE);
-    }
+        Vertex* v = _ordered_vertices[i];
+        if (v == nullptr || v->is_property () || v->is_invalid ()) continue;
+        execute (v);
+      }
+      for (size_t i = 0; i < _output_nodes.size (); i++) {
+        if (!_sorted) break;
+        execute (_output_nodes[i]);
+      }
     if (!_sorted) {
       sort ();
       is_end = false;
     }
    }
+  }
+
+  void
+  Graph::exec_scheduled ()
+  {
+    bool is_end = false;
+    while (!is_end) {
+      is_end = true;
+      while (!_activation_queue.empty ()) {
+        if (!_sorted)
+          sort ();
+        std::pop_heap (_activation_queue.begin (), _activation_queue.end (), later_in_order);
+        Vertex* v = _activation_queue.back ();
+        _activation_queue.pop_back ();
+        v->set_scheduled (false);
+        if (v->get_position () == -1 || v->is_property () || v->is_invalid ()) continue;
+        execute (v);
+      }
+      for (size_t i = 0; i < _output_nodes.size (); i++) {
+        if (_output_nodes[i]->get_process ()->get_activation_flag () != NONE)
+          execute (_output_nodes[i]);
+      }
+      if (!_activation_queue.empty ())
+        is_end = false;
+    }
+    sort ();
+  }
+
+  void
+  Graph::compute_levels ()
+  {
+    /* the order puts every vertex after its predecessors, except on cycles */
+    for (auto v : _ordered_vertices) {
+      if (v != nullptr)
+        v->set_level (0);
+    }
+    for (auto v : _ordered_vertices) {
+      if (v == nullptr)
+        continue;
+      for (auto w : v->get_edges ()) {
+        if (w->get_position () > v->get_position () && w->get_level () <= v->get_level ())
+          w->set_level (v->get_level () + 1);
+      }
+    }
+    _levels_dirty = false;
+  }
+
+  /* same as exec_scheduled, but all the pending vertices of the lowest level
+   * are taken at once and run side by side */
+  void
+  Graph::exec_parallel ()
+  {
+    Vertex::vertices_t wave, rest;
+    bool is_end = false;
+    while (!is_end) {
+      is_end = true;
+      while (!_activation_queue.empty ()) {
+        if (!_sorted)
+          sort ();
+        if (_levels_dirty)
+          compute_levels ();
+        int level = INT_MAX;
+        for (auto v : _activation_queue) {
+          if (v->get_position () != -1 && !v->is_property () && !v->is_invalid () && v->get_level () < level)
+            level = v->get_level ();
+        }
+        wave.clear ();
+        rest.clear ();
+        for (auto v : _activation_queue) {
+          if (v->get_position () == -1 || v->is_property () || v->is_invalid ())
+            v->set_scheduled (false);
+          else if (v->get_level () == level) {
+            v->set_scheduled (false);
+            wave.push_back (v);
+          } else
+            rest.push_back (v);
+        }
+        _activation_queue.swap (rest);
+        std::make_heap (_activation_queue.begin (), _activation_queue.end (), later_in_order);
+        run_wave (wave);
+      }
+      for (size_t i = 0; i < _output_nodes.size (); i++) {
+        if (_output_nodes[i]->get_process ()->get_activation_flag () != NONE)
+          execute (_output_nodes[i]);
+      }
+      if (!_activation_queue.empty ())
+        is_end = false;
+    }
+    sort ();
+  }
+
+  void
+  Graph::run_wave (Vertex::vertices_t& wave)
+  {
+    std::sort (wave.begin (), wave.end (), [] (Vertex* v1, Vertex* v2) { return v1->get_position () < v2->get_position (); });
+    Vertex::vertices_t parallel, main_thread;
+    for (auto v : wave) {
+      if (v->get_process ()->is_thread_safe ())
+        parallel.push_back (v);
+      else
+        main_thread.push_back (v);
+    }
+    if (parallel.size () > 1) {
+      /* the workers only run the activations: what they trigger goes through
+       * the graph and the tree, which are not thread-safe, and is done here
+       * after the wave, in the graph order */
+      std::vector<propagations_t> propagations (parallel.size ());
+      _in_parallel_wave = true;
+      _pool->parallel_for (parallel.size (), [this, &parallel, &propagations] (int i) {
+        deferred_propagations = &propagations[i];
+        execute (parallel[i]);
+        deferred_propagations = nullptr;
+      });
+      _in_parallel_wave = false;
+      for (auto& l : propagations) {
+        for (auto& p : l) {
+          if (p.second == ACTIVATION)
+            p.first->notify_activation ();
+          else
+            p.first->notify_deactivation ();
+        }
+      }
+    } else if (parallel.size () == 1)
+      execute (parallel[0]);
+    /* one of them may have deleted the process of a later one */
+    for (auto v : main_thread) {
+      if (!v->is_invalid ())
+        execute (v);
+    }
+  }
+
+  void
+  Graph::exec ()
+  {
+    if (_update_depth > 0 && _exec_depth == 0)
+      return;
+
+    //graph_mutex.lock ();
+
+    bool profile = _exec_depth == 0 && Profiler::instance ().is_enabled ();
+    struct timespec start;
+    if (profile)
+      get_monotonic_time (&start);
+
+    _exec_depth++;
+    if (_scheduling_mode == WORKLIST_SCHEDULING && _pool != nullptr)
+      exec_parallel ();
+    else if (_scheduling_mode == WORKLIST_SCHEDULING)
+      exec_scheduled ();
+    else
+      exec_sorted ();
+    _exec_depth--;
+
+    if (!_to_reclaim.empty () && _exec_depth == 0)
+      reclaim ();
+
+    if (profile)
+      Profiler::instance ().record_exec (elapsed_ms (start));
+
    //graph_mutex.unlock ();
+  }
+
+  void
+  Graph::begin_update ()
+  {
+    _update_depth++;
+  }
 
-#if _PERF_TEST
-      double time = t2 ("\nGRAPH_EXEC : ");
-      graph_counter = graph_counter + 1;
-      graph_total = graph_total + time ;
-      graph_average = graph_total / graph_counter;
-      cerr << "GRAPH_EXEC : " << graph_counter << " - avg: " << graph_average << endl; 
-#endif
+  void
+  Graph::commit ()
+  {
+    if (_update_depth == 0) {
+      std::cerr << "Warning: Graph::commit without begin_update\n";
+      return;
+    }
+    if (--_update_depth == 0)
+      exec ();
   }
 
 }
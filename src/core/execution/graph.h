@@ -19,6 +19,7 @@
 
 #include <mutex>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <memory>
 
@@ -34,11 +35,26 @@ namespace djnn
     virtual ~Vertex () { } ;
     typedef std::vector< Vertex* > vertices_t;
 
-    void add_edge (Vertex* dst);
-    void remove_edge (Vertex* dst);
+    /* edges are added and removed through the Graph, which indexes them */
     vertices_t& get_edges () { return _edges; }
     const vertices_t& get_edges () const { return _edges; }
-    int get_count_egdes_in () { return _count_egdes_in; }
+    vertices_t& get_in_edges () { return _in_edges; }
+    const vertices_t& get_in_edges () const { return _in_edges; }
+    int get_count_egdes_in () { return _in_edges.size (); }
+
+    /* position in the topological order, -1 when the vertex is not part of the graph */
+    void set_position (int pos) { _position = pos; }
+    int get_position () const { return _position; }
+    bool is_property () const { return _is_property; }
+
+    /* length of the longest path reaching the vertex: vertices of the same
+     * level don't depend on each other */
+    void set_level (int l) { _level = l; }
+    int get_level () const { return _level; }
+
+    /* true while the vertex waits in the activation queue */
+    void set_scheduled (bool s) { _is_scheduled = s; }
+    bool is_scheduled () const { return _is_scheduled; }
 
     void set_mark (int m) { _mark = m; }
     int get_mark () const { return _mark; }
@@ -55,16 +71,64 @@ namespace djnn
     void print_vertex () const;
     void invalidate () { _is_invalid = true; }
     bool is_invalid () { return _is_invalid; }
+    /* an invalid vertex may still belong to a live process, left isolated */
+    void set_process_deleted () { _is_process_deleted = true; }
+    bool is_process_deleted () const { return _is_process_deleted; }
 
   private:
+    friend class Graph;
     Process* _vertex;
     vertices_t _edges;
-    int _mark, _start_date, _end_date, _count_egdes_in;
+    vertices_t _in_edges;
+    int _mark, _start_date, _end_date;
+    int _position;
+    int _level;
     bool _is_invalid;
+    bool _is_process_deleted;
+    bool _is_property;
+    bool _is_scheduled;
+  };
+
+  /* FULL_SORT rebuilds the whole order (DFS + sort) after any change,
+   * INCREMENTAL_SORT maintains it edge by edge (Pearce-Kelly),
+   * CHECKED_SORT is INCREMENTAL_SORT validated against a full sort on every pass */
+  enum ordering_mode_t
+  {
+    FULL_SORT,
+    INCREMENTAL_SORT,
+    CHECKED_SORT
+  };
+
+  /* SCAN_SCHEDULING (the default) visits every vertex of the order on each exec,
+   * WORKLIST_SCHEDULING only visits the vertices whose activation flag was set:
+   * cheaper when few of them are, but the upkeep of its heap makes it slower
+   * than the scan when most of the graph runs */
+  enum scheduling_mode_t
+  {
+    SCAN_SCHEDULING,
+    WORKLIST_SCHEDULING
   };
 
+  class ThreadPool;
+
   class Graph
   {
+    /* multiplicity of an edge and its slots in the adjacency vectors of both ends */
+    struct edge_info_t
+    {
+      int count;
+      int out_index;
+      int in_index;
+    };
+    typedef std::pair<Vertex*, Vertex*> edge_key_t;
+    struct edge_key_hash
+    {
+      size_t operator() (const edge_key_t& k) const
+      {
+        return std::hash<Vertex*> () (k.first) ^ (std::hash<Vertex*> () (k.second) * 31);
+      }
+    };
+
   public:
     virtual ~Graph ();
     static Graph& instance ();
@@ -73,13 +137,37 @@ namespace djnn
     void remove_output_node (Process* c);
     void add_edge (Process* src, Process* dst);
     void remove_edge (Process* src, Process* dst);
-    void remove_properties ();
     void sort ();
     void exec ();
+    /* between begin_update and the matching commit, the top-level calls to exec
+     * do nothing: the activations accumulate and the outermost commit
+     * runs them all in a single pass */
+    void begin_update ();
+    void commit ();
+    bool in_update () const { return _update_depth > 0; }
     void clear ();
     void print_graph ();
     void print_sorted ();
-    Vertex::vertices_t get_sorted () { return _sorted_vertices; }
+    Vertex::vertices_t get_sorted ();
+    void set_ordering_mode (ordering_mode_t mode);
+    ordering_mode_t get_ordering_mode () const { return _ordering_mode; }
+    int check_order ();
+    void set_scheduling_mode (scheduling_mode_t mode);
+    scheduling_mode_t get_scheduling_mode () const { return _scheduling_mode; }
+    void schedule_activation (Vertex* v);
+    /* 0 (the default) executes everything on the calling thread, otherwise the
+     * activated vertices of each level that are thread-safe processes run on
+     * a pool of nb_threads threads; this switches to WORKLIST_SCHEDULING,
+     * which the parallel execution requires */
+    void set_parallel_execution (int nb_threads);
+    int get_parallel_execution () const;
+    /* called by a process about to propagate its couplings: true if they are
+     * left to the calling thread, the process running in a parallel wave */
+    static bool defer_propagation (Process* p, int flag);
+    void remove_vertex (Vertex* v);
+    size_t reclaim ();
+    size_t get_reclaimed_bytes () const { return _reclaimed_bytes; }
+    int get_reclaimed_vertices () const { return _reclaimed_vertices; }
 
   private:
     static Graph* _instance;
@@ -87,11 +175,49 @@ namespace djnn
     Graph ();
     void browse_in_depth (Vertex* v);
     Vertex* get_vertex (Process* c);
-    Vertex::vertices_t _vertices;
-    Vertex::vertices_t _sorted_vertices;
+    void insert_vertex (Vertex* v);
+    void detach_edge (Vertex* src, Vertex* dst);
+    void discard_if_isolated (Vertex* v);
+    void full_sort ();
+    void execute (Vertex* v);
+    void exec_sorted ();
+    void exec_scheduled ();
+    void exec_parallel ();
+    void run_wave (Vertex::vertices_t& wave);
+    void compute_levels ();
+    void push_activation (Vertex* v);
+    void reorder (Vertex* src, Vertex* dst);
+    void compact ();
+    std::unordered_map<edge_key_t, edge_info_t, edge_key_hash> _edges;
+    Vertex::vertices_t _ordered_vertices;
     Vertex::vertices_t _output_nodes;
+    Vertex::vertices_t _activation_queue;
+    Vertex::vertices_t _to_reclaim;
+    ThreadPool* _pool;
+    std::mutex _queue_mutex;
+    size_t _reclaimed_bytes;
+    int _reclaimed_vertices;
     int _cur_date;
+    int _nb_holes;
+    int _exec_depth;
+    int _update_depth;
     bool _sorted;
+    bool _full_sort_needed;
+    bool _levels_dirty;
+    bool _in_parallel_wave;
+    ordering_mode_t _ordering_mode;
+    scheduling_mode_t _scheduling_mode;
+  };
+
+  /* scoped batch of updates: the graph runs once, when the guard goes out of scope */
+  class GraphUpdate
+  {
+  public:
+    GraphUpdate () { Graph::instance ().begin_update (); }
+    ~GraphUpdate () { Graph::instance ().commit (); }
+  private:
+    GraphUpdate (const GraphUpdate&) = delete;
+    GraphUpdate & operator= (const GraphUpdate&) = delete;
   };
 
 }
@@ -0,0 +1,191 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "profiler.h"
+#include "../tree/process.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace djnn
+{
+  Profiler* Profiler::_instance;
+  std::once_flag Profiler::onceFlag;
+
+  Profiler&
+  Profiler::instance ()
+  {
+    std::call_once (Profiler::onceFlag, [] () {
+      _instance = new Profiler ();
+    });
+
+    return *(_instance);
+  }
+
+  Profiler::Profiler () :
+      _nb_exec (0), _exec_time (0), _max_exec_time (0), _enabled (false)
+  {
+  }
+
+  void
+  Profiler::reset ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _entries.clear ();
+    _all.clear ();
+    _nb_exec = 0;
+    _exec_time = 0;
+    _max_exec_time = 0;
+  }
+
+  static std::string
+  path_of (Process* p)
+  {
+    std::string path = p->get_name ();
+    for (Process* q = p->get_parent (); q != nullptr; q = q->get_parent ())
+      path = q->get_name () + "/" + path;
+    return path;
+  }
+
+  Profiler::entry_t*
+  Profiler::enter (Process* p, int action)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    auto it = _entries.find (p);
+    if (it == _entries.end ()) {
+      _all.push_back ({ path_of (p), p->debug_info (), 0, 0, 0, 0, 0, 0 });
+      it = _entries.insert (std::make_pair (p, &_all.back ())).first;
+    }
+    entry_t& e = *it->second;
+    if (action == ACTIVATION)
+      e.nb_activations++;
+    else
+      e.nb_deactivations++;
+    return &e;
+  }
+
+  void
+  Profiler::record (entry_t* e, int action, double time)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (action == ACTIVATION) {
+      e->activation_time += time;
+      e->max_activation_time = std::max (e->max_activation_time, time);
+    } else {
+      e->deactivation_time += time;
+      e->max_deactivation_time = std::max (e->max_deactivation_time, time);
+    }
+  }
+
+  void
+  Profiler::record_exec (double time)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _nb_exec++;
+    _exec_time += time;
+    _max_exec_time = std::max (_max_exec_time, time);
+  }
+
+  void
+  Profiler::retire (Process* p)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _entries.erase (p);
+  }
+
+  std::vector<Profiler::entry_t>
+  Profiler::get_entries ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    std::vector<entry_t> entries (_all.begin (), _all.end ());
+    std::sort (entries.begin (), entries.end (),
+               [] (const entry_t& e1, const entry_t& e2) { return e1.total_time () > e2.total_time (); });
+    return entries;
+  }
+
+  void
+  Profiler::report (std::ostream& os, int max_entries)
+  {
+    std::vector<entry_t> entries = get_entries ();
+    double avg = _nb_exec ? _exec_time / _nb_exec : 0;
+    os << "GRAPH_EXEC: " << _nb_exec << " - total: " << _exec_time << " ms - avg: " << avg << " ms - max: " << _max_exec_time << " ms\n";
+    os << std::setw (10) << "total ms" << std::setw (8) << "%" << std::setw (9) << "act" << std::setw (10) << "max ms"
+        << std::setw (9) << "deact" << std::setw (10) << "max ms" << "  process\n";
+    int n = 0;
+    for (auto& e : entries) {
+      if (max_entries > 0 && n++ == max_entries)
+        break;
+      os << std::fixed << std::setprecision (3)
+          << std::setw (10) << e.total_time ()
+          << std::setw (8) << std::setprecision (1) << (_exec_time > 0 ? 100 * e.total_time () / _exec_time : 0)
+          << std::setw (9) << e.nb_activations << std::setw (10) << std::setprecision (3) << e.max_activation_time
+          << std::setw (9) << e.nb_deactivations << std::setw (10) << e.max_deactivation_time
+          << "  " << e.name << " (" << e.debug_info << ")\n";
+    }
+    os << std::defaultfloat;
+  }
+
+  static void
+  json_string (std::ostream& os, const std::string& s)
+  {
+    os << '"';
+    for (char c : s) {
+      switch (c) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+          if ((unsigned char) c < 0x20)
+            os << "\\u" << std::hex << std::setw (4) << std::setfill ('0') << (int) c << std::dec << std::setfill (' ');
+          else
+            os << c;
+      }
+    }
+    os << '"';
+  }
+
+  void
+  Profiler::dump_json (std::ostream& os)
+  {
+    std::vector<entry_t> entries = get_entries ();
+    os << "{\n  \"exec\": { \"count\": " << _nb_exec << ", \"total_ms\": " << _exec_time
+        << ", \"max_ms\": " << _max_exec_time << " },\n  \"vertices\": [";
+    for (size_t i = 0; i < entries.size (); i++) {
+      entry_t& e = entries[i];
+      os << (i ? ",\n    { " : "\n    { ") << "\"name\": ";
+      json_string (os, e.name);
+      os << ", \"debug_info\": ";
+      json_string (os, e.debug_info);
+      os << ", \"activations\": " << e.nb_activations << ", \"activation_ms\": " << e.activation_time
+          << ", \"max_activation_ms\": " << e.max_activation_time << ", \"deactivations\": " << e.nb_deactivations
+          << ", \"deactivation_ms\": " << e.deactivation_time << ", \"max_deactivation_ms\": " << e.max_deactivation_time
+          << " }";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  bool
+  Profiler::dump_json (const std::string& filename)
+  {
+    std::ofstream os (filename);
+    if (!os) {
+      std::cerr << "Warning: unable to write profile to " << filename << std::endl;
+      return false;
+    }
+    dump_json (os);
+    return true;
+  }
+}
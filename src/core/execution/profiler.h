@@ -0,0 +1,91 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace djnn
+{
+  class Process;
+
+  /* Per-process statistics of the graph execution. Disabled by default,
+   * it can be switched on and off at any time, e.g. around the frames to study.
+   * Times are in milliseconds. */
+  class Profiler
+  {
+  public:
+    struct entry_t
+    {
+      std::string name;
+      std::string debug_info;
+      int nb_activations;
+      int nb_deactivations;
+      double activation_time;
+      double deactivation_time;
+      double max_activation_time;
+      double max_deactivation_time;
+      double total_time () const { return activation_time + deactivation_time; }
+    };
+
+    static Profiler& instance ();
+    virtual ~Profiler () {}
+    void set_enabled (bool enabled) { _enabled = enabled; }
+    bool is_enabled () const { return _enabled; }
+    void reset ();
+
+    /* called by the graph, safe from the threads of a parallel wave: enter
+     * counts the action of a process that still exists and returns its entry,
+     * record charges the time to that entry, still there if the action
+     * deleted the process */
+    entry_t* enter (Process* p, int action);
+    void record (entry_t* e, int action, double time);
+    void record_exec (double time);
+    /* keeps the statistics of a deleted process out of the way of a new process at the same address */
+    void retire (Process* p);
+
+    /* entries sorted by decreasing total time */
+    std::vector<entry_t> get_entries ();
+    int get_nb_exec () const { return _nb_exec; }
+    double get_exec_time () const { return _exec_time; }
+    double get_max_exec_time () const { return _max_exec_time; }
+
+    /* max_entries = 0 prints all the entries */
+    void report (std::ostream& os = std::cerr, int max_entries = 50);
+    void dump_json (std::ostream& os);
+    bool dump_json (const std::string& filename);
+
+  private:
+    Profiler ();
+    Profiler (const Profiler&) = delete;
+    Profiler & operator= (const Profiler&) = delete;
+    static Profiler* _instance;
+    static std::once_flag onceFlag;
+    /* the entries never move, those of the deleted processes are only
+     * taken out of the index */
+    std::deque<entry_t> _all;
+    std::unordered_map<Process*, entry_t*> _entries;
+    std::mutex _mutex;
+    int _nb_exec;
+    double _exec_time;
+    double _max_exec_time;
+    std::atomic<bool> _enabled;
+  };
+}
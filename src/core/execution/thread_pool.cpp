@@ -0,0 +1,123 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "thread_pool.h"
+
+#include <iostream>
+
+namespace djnn
+{
+  using namespace std;
+
+  ThreadPool::ThreadPool (int nb_threads) :
+      _job (nullptr), _remaining (0), _generation (0), _stop (false)
+  {
+    if (nb_threads < 1)
+      nb_threads = 1;
+    for (int i = 0; i < nb_threads; i++)
+      _workers.push_back (new Worker);
+    /* worker 0 is the thread calling parallel_for */
+    for (int i = 1; i < nb_threads; i++)
+      _threads.push_back (std::thread (&ThreadPool::work, this, i));
+  }
+
+  ThreadPool::~ThreadPool ()
+  {
+    {
+      std::lock_guard<std::mutex> lock (_mutex);
+      _stop = true;
+    }
+    _cond_start.notify_all ();
+    for (auto& t : _threads)
+      t.join ();
+    for (auto w : _workers)
+      delete w;
+  }
+
+  void
+  ThreadPool::parallel_for (int n, const std::function<void (int)>& f)
+  {
+    if (n <= 0)
+      return;
+    _job = &f;
+    _remaining = n;
+    int nb_workers = _workers.size ();
+    for (int i = 0; i < nb_workers; i++) {
+      std::lock_guard<std::mutex> lock (_workers[i]->mutex);
+      for (int t = i; t < n; t += nb_workers)
+        _workers[i]->tasks.push_back (t);
+    }
+    {
+      std::lock_guard<std::mutex> lock (_mutex);
+      _generation++;
+    }
+    _cond_start.notify_all ();
+
+    while (run_one (0))
+      ;
+    std::unique_lock<std::mutex> lock (_mutex);
+    _cond_done.wait (lock, [this] () { return _remaining == 0; });
+  }
+
+  /* run a task from the worker's own deque, or else stolen from another one */
+  bool
+  ThreadPool::run_one (int id)
+  {
+    int nb_workers = _workers.size ();
+    for (int i = 0; i < nb_workers; i++) {
+      Worker* w = _workers[(id + i) % nb_workers];
+      int task;
+      {
+        std::lock_guard<std::mutex> lock (w->mutex);
+        if (w->tasks.empty ())
+          continue;
+        if (i == 0) {
+          task = w->tasks.front ();
+          w->tasks.pop_front ();
+        } else {
+          task = w->tasks.back ();
+          w->tasks.pop_back ();
+        }
+      }
+      try {
+        (*_job) (task);
+      } catch (exception& e) {
+        cerr << "Warning: exception in a parallel task: " << e.what () << endl;
+      }
+      if (--_remaining == 0) {
+        std::lock_guard<std::mutex> lock (_mutex);
+        _cond_done.notify_all ();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void
+  ThreadPool::work (int id)
+  {
+    int seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock (_mutex);
+        _cond_start.wait (lock, [this, seen] () { return _stop || _generation != seen; });
+        if (_stop)
+          return;
+        seen = _generation;
+      }
+      while (run_one (id))
+        ;
+    }
+  }
+}
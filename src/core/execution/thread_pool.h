@@ -0,0 +1,57 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djnn
+{
+  /* Fixed set of worker threads running batches of independent tasks.
+   * Each worker owns a deque of task indices, takes work from its front and
+   * steals from the back of the others when it runs dry. The calling thread
+   * takes part in the batch as worker 0. */
+  class ThreadPool
+  {
+  public:
+    ThreadPool (int nb_threads);
+    virtual ~ThreadPool ();
+    int size () const { return _workers.size (); }
+    /* run f (i) for i in [0, n) and return when all of them are done */
+    void parallel_for (int n, const std::function<void (int)>& f);
+
+  private:
+    struct Worker
+    {
+      std::mutex mutex;
+      std::deque<int> tasks;
+    };
+    void work (int id);
+    bool run_one (int id);
+    std::vector<Worker*> _workers;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _cond_start, _cond_done;
+    const std::function<void (int)>* _job;
+    std::atomic<int> _remaining;
+    int _generation;
+    bool _stop;
+  };
+}
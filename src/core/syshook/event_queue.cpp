@@ -0,0 +1,153 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "event_queue.h"
+#include "../execution/graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+namespace djnn
+{
+  EventQueue* EventQueue::_instance;
+  std::once_flag EventQueue::onceFlag;
+
+  EventQueue&
+  EventQueue::instance ()
+  {
+    std::call_once (EventQueue::onceFlag, [] () {
+      _instance = new EventQueue ();
+    });
+
+    return *(_instance);
+  }
+
+  EventQueue::EventQueue () :
+      _head (&_stub), _tail (&_stub), _depth (0), _pending (false), _nb_posted (0),
+      _nb_drained (0), _nb_drains (0), _max_depth (0), _total_wait (0), _max_wait (0)
+  {
+    _stub.next.store (nullptr);
+  }
+
+  void
+  EventQueue::push (Node* n)
+  {
+    n->next.store (nullptr, std::memory_order_relaxed);
+    Node* prev = _head.exchange (n, std::memory_order_acq_rel);
+    prev->next.store (n, std::memory_order_release);
+  }
+
+  /* returns nullptr when empty, or when the last node is still being linked
+   * by its producer: that one will be taken by the next drain */
+  EventQueue::Node*
+  EventQueue::pop ()
+  {
+    Node* tail = _tail;
+    Node* next = tail->next.load (std::memory_order_acquire);
+    if (tail == &_stub) {
+      if (next == nullptr)
+        return nullptr;
+      _tail = next;
+      tail = next;
+      next = next->next.load (std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      _tail = next;
+      return tail;
+    }
+    if (tail != _head.load (std::memory_order_acquire))
+      return nullptr;
+    push (&_stub);
+    next = tail->next.load (std::memory_order_acquire);
+    if (next != nullptr) {
+      _tail = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  void
+  EventQueue::post (std::function<void ()> event)
+  {
+    Node* n = new Node;
+    n->event = std::move (event);
+    n->date = std::chrono::steady_clock::now ();
+    push (n);
+    _depth++;
+    _nb_posted++;
+    /* only the post that finds the queue idle wakes up the main loop */
+    if (!_pending.exchange (true)) {
+      std::lock_guard<std::mutex> lock (_wakeup_mutex);
+      if (_wakeup)
+        _wakeup ();
+    }
+  }
+
+  int
+  EventQueue::drain ()
+  {
+    _pending.store (false);
+    int depth = _depth.load ();
+    if (depth == 0)
+      return 0;
+    _max_depth = std::max (_max_depth, depth);
+    _nb_drains++;
+    int n = 0;
+    GraphUpdate update; // executing once at the end of the drain
+    while (Node* node = pop ()) {
+      double wait = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - node->date).count ();
+      _total_wait += wait;
+      _max_wait = std::max (_max_wait, wait);
+      _depth--;
+      n++;
+      try {
+        node->event ();
+      } catch (std::exception& e) {
+        std::cerr << e.what () << std::endl;
+      }
+      delete node;
+    }
+    _nb_drained += n;
+    return n;
+  }
+
+  void
+  EventQueue::set_wakeup (std::function<void ()> wakeup)
+  {
+    std::lock_guard<std::mutex> lock (_wakeup_mutex);
+    /* one main loop at a time: the previous owner must remove its hook first */
+    assert (!_wakeup || !wakeup);
+    _wakeup = wakeup;
+  }
+
+  EventQueue::stats_t
+  EventQueue::get_stats ()
+  {
+    stats_t s = { _nb_posted.load (), _nb_drained, _nb_drains, _depth.load (), _max_depth, _total_wait, _max_wait };
+    return s;
+  }
+
+  void
+  EventQueue::reset_stats ()
+  {
+    _nb_posted = 0;
+    _nb_drained = 0;
+    _nb_drains = 0;
+    _max_depth = 0;
+    _total_wait = 0;
+    _max_wait = 0;
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace djnn
+{
+  /* Events posted by external threads to the main loop without taking the
+   * exclusive access. Posting is lock-free (an intrusive multi-producer,
+   * single-consumer queue); the main loop drains the queue with the
+   * exclusive access held, runs every event and executes the graph once
+   * for the whole batch. The wake-up hook is called by the post that makes
+   * the queue non-empty, so that the main loop comes to drain it. */
+  class EventQueue
+  {
+  public:
+    struct stats_t
+    {
+      unsigned long nb_posted, nb_drained, nb_drains;
+      int depth, max_depth;
+      double total_wait_ms, max_wait_ms;
+    };
+
+    static EventQueue& instance ();
+    void post (std::function<void ()> event);
+    /* the target must still be alive when the queue is drained */
+    template <typename P, typename V> void post_set_value (P* p, V v)
+    {
+      post ([p, v] () { p->set_value (v, true); });
+    }
+    /* with the exclusive access held; returns the number of events run */
+    int drain ();
+    bool empty () const { return _depth.load () == 0; }
+    /* installed by the main loop that drains the queue: the external one
+     * (Qt) if any, otherwise MainLoop while it waits for events; nullptr
+     * removes it */
+    void set_wakeup (std::function<void ()> wakeup);
+    stats_t get_stats ();
+    void reset_stats ();
+
+  private:
+    struct Node
+    {
+      std::atomic<Node*> next;
+      std::function<void ()> event;
+      std::chrono::steady_clock::time_point date;
+    };
+
+    EventQueue ();
+    void push (Node* n);
+    Node* pop ();
+
+    static EventQueue* _instance;
+    static std::once_flag onceFlag;
+    std::atomic<Node*> _head;
+    Node* _tail;
+    Node _stub;
+    std::atomic<int> _depth;
+    std::atomic<bool> _pending;
+    std::atomic<unsigned long> _nb_posted;
+    std::mutex _wakeup_mutex;
+    std::function<void ()> _wakeup;
+    /* updated by the consumer only */
+    unsigned long _nb_drained, _nb_drains;
+    int _max_depth;
+    double _total_wait, _max_wait;
+  };
+}
@@ -1,9 +1,11 @@
 #include "main_loop.h"
+#include "event_queue.h"
 
 namespace djnn {
 
     // MainLoop should be created *before* any other external-source (is activated ?) -- or not ?
-    MainLoop::MainLoop ()
+    MainLoop::MainLoop () :
+      _woken (false), _stop (false)
     {
       set_run_for_ever ();
       djnn::get_exclusive_access (DBG_GET); // get hand to prevent any other thread from launching
@@ -14,6 +16,7 @@ namespace djnn {
     void
     MainLoop::activate ()
     {
+      _stop = false;
       for (auto p: _background_processes) {
         p->activation ();
       }
@@ -33,10 +36,20 @@ namespace djnn {
       if (another_source_wants_to_be_mainloop) {
         another_source_wants_to_be_mainloop->please_stop ();
       } else {
-        own_mutex.unlock ();
+        std::lock_guard<std::mutex> lock (_wait_mutex);
+        _stop = true;
+        _wait_cond.notify_one ();
       }
     }
 
+    void
+    MainLoop::wake_up ()
+    {
+      std::lock_guard<std::mutex> lock (_wait_mutex);
+      _woken = true;
+      _wait_cond.notify_one ();
+    }
+
     void
     MainLoop::run_in_main_thread ()
     {
@@ -55,6 +68,10 @@ namespace djnn {
       //private_run();
       djnn::release_exclusive_access (DBG_REL); // launch other threads
 
+      if (!another_source_wants_to_be_mainloop) {
+        run_event_loop ();
+        return;
+      }
       if (is_run_forever ()) {
         own_mutex.lock (); // 1st lock: success
         own_mutex.lock (); // 2nd lock: blocks forever
@@ -65,5 +82,31 @@ namespace djnn {
         another_source_wants_to_be_mainloop->please_stop ();
     }
 
+    void
+    MainLoop::run_event_loop ()
+    {
+      /* the external main loop, if any, owns the wake-up hook */
+      EventQueue::instance ().set_wakeup ([this] () { wake_up (); });
+      if (!EventQueue::instance ().empty ())
+        wake_up ();
+      auto end = std::chrono::steady_clock::now () + _duration;
+      std::unique_lock<std::mutex> lock (_wait_mutex);
+      while (!_stop) {
+        if (is_run_forever ())
+          _wait_cond.wait (lock, [this] () { return _stop || _woken; });
+        else if (!_wait_cond.wait_until (lock, end, [this] () { return _stop || _woken; }))
+          break;
+        if (_stop)
+          break;
+        _woken = false;
+        lock.unlock ();
+        djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
+        EventQueue::instance ().drain ();
+        djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
+        lock.lock ();
+      }
+      lock.unlock ();
+      EventQueue::instance ().set_wakeup (nullptr);
+    }
 
 }
@@ -20,6 +20,7 @@
 
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <iostream>
 
 namespace djnn
@@ -62,7 +63,17 @@ namespace djnn
     void
     run ();
 
+    /* without another main loop: waits for the events posted to the event queue */
+    void
+    run_event_loop ();
+
+    void
+    wake_up ();
+
     std::mutex own_mutex;
+    std::mutex _wait_mutex;
+    std::condition_variable _wait_cond;
+    bool _woken, _stop;
     std::chrono::milliseconds _duration;
 
   private:
@@ -19,10 +19,6 @@
 #include "../execution/graph.h"
 #include "../serializer/serializer.h"
 
-#include <boost/chrono.hpp>
-#include <boost/thread/thread.hpp>
-
-
 #include <iostream>
 
 #define DBG std::cerr << __FILE__ ":" << __LINE__ << ":" << __FUNCTION__ << std::endl;
@@ -59,6 +55,7 @@ namespace djnn
 
   Timer::~Timer ()
   {
+    TimerService::instance ().cancel (this);
     if (_end) { delete _end; _end = nullptr;}
     if (_delay) { delete _delay; _delay = nullptr;}
   }
@@ -68,36 +65,20 @@ namespace djnn
   {
     if (_activation_state == activated)
       return;
-    set_please_stop (false);
-    start_thread();
+    TimerService::instance ().schedule (this, timer_clock_t::now () + std::chrono::milliseconds (_delay->get_value ()));
   }
 
   void
   Timer::deactivate ()
   {
-    please_stop ();
+    TimerService::instance ().cancel (this);
   }
 
   void
-  Timer::run ()
+  Timer::do_timer ()
   {
-    //DBG;
-    try {
-        boost
-        ::chrono::milliseconds duration (_delay->get_value ());
-        boost
-        ::this_thread::sleep_for (duration); // blocking call
-        djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
-        if (!get_please_stop ()) {
-          _activation_state = deactivated;
-          _end->notify_activation (); // propagating
-          GRAPH_EXEC; // executing
-        }
-        djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
-    } catch (exception& e) {
-      std::cerr << e.what() << std::endl;
-    }
-    //deactivation ();
+    _activation_state = deactivated;
+    _end->notify_activation (); // propagating, executed by the timer service
   }
 
   void
@@ -106,7 +87,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("core:timer");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("delay", _delay->get_value ());
     AbstractSerializer::serializer->end ();
 
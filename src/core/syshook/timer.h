@@ -17,14 +17,14 @@
 
 #include "../tree/process.h"
 #include "../tree/blank.h"
-#include "external_source.h"
+#include "timer_service.h"
 
 #include <chrono>
 
 namespace djnn
 {
 
-  class Timer : public Process, public ExternalSource
+  class Timer : public Process, public TimerClient
   {
   public:
     Timer (Process* p, const std::string& n, std::chrono::milliseconds period = 1000ms);
@@ -43,7 +43,7 @@ namespace djnn
     IntProperty *_delay;
     Blank *_end;
 
-    void run() override;
+    void do_timer () override;
   };
 
 }
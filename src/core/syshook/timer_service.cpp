@@ -0,0 +1,199 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "timer_service.h"
+#include "syshook.h"
+#include "../execution/graph.h"
+
+#include <iostream>
+
+namespace djnn
+{
+  TimerClient::~TimerClient ()
+  {
+    TimerService::instance ().cancel (this);
+  }
+
+  TimerService* TimerService::_instance;
+  std::once_flag TimerService::onceFlag;
+
+  TimerService&
+  TimerService::instance ()
+  {
+    std::call_once (TimerService::onceFlag, [] () {
+      _instance = new TimerService ();
+    });
+
+    return *(_instance);
+  }
+
+  TimerService::TimerService () :
+      _thread (nullptr)
+  {
+  }
+
+  void
+  TimerService::schedule (TimerClient* c, timer_date_t deadline)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    /* a client rescheduled while its batch is being delivered waits for its new deadline */
+    drop_from_batch (c);
+    c->_deadline = deadline;
+    if (c->_heap_index >= 0) {
+      sift_up (c->_heap_index);
+      sift_down (c->_heap_index);
+    } else
+      push (c);
+    if (_thread == nullptr)
+      _thread = new std::thread (&TimerService::run, this);
+    else if (c->_heap_index == 0)
+      _cond.notify_one ();
+  }
+
+  void
+  TimerService::cancel (TimerClient* c)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    drop_from_batch (c);
+    if (c->_heap_index >= 0)
+      remove (c->_heap_index);
+  }
+
+  int
+  TimerService::nb_scheduled ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    return _heap.size ();
+  }
+
+  void
+  TimerService::run ()
+  {
+    std::unique_lock<std::mutex> lock (_mutex);
+    for (;;) {
+      if (_heap.empty ()) {
+        _cond.wait (lock);
+        continue;
+      }
+      if (_cond.wait_until (lock, _heap[0]->_deadline) == std::cv_status::no_timeout)
+        continue;
+      if (_heap.empty () || _heap[0]->_deadline > timer_clock_t::now ())
+        continue;
+
+      /* same order as the clients scheduling from the graph: exclusive access, then our mutex */
+      lock.unlock ();
+      djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
+      lock.lock ();
+      timer_date_t now = timer_clock_t::now ();
+      while (!_heap.empty () && _heap[0]->_deadline <= now) {
+        _batch.push_back (_heap[0]);
+        remove (0);
+      }
+      lock.unlock ();
+      {
+        GraphUpdate update; // executing once at the end of the block
+        for (size_t i = 0;; i++) {
+          TimerClient* c;
+          {
+            std::lock_guard<std::mutex> batch_lock (_mutex);
+            if (i >= _batch.size ())
+              break;
+            c = _batch[i];
+          }
+          if (c == nullptr)
+            continue;
+          try {
+            c->do_timer ();
+          } catch (std::exception& e) {
+            std::cerr << e.what () << std::endl;
+          }
+        }
+      }
+      lock.lock ();
+      _batch.clear ();
+      djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
+    }
+  }
+
+  void
+  TimerService::drop_from_batch (TimerClient* c)
+  {
+    for (auto& b : _batch)
+      if (b == c)
+        b = nullptr;
+  }
+
+  void
+  TimerService::push (TimerClient* c)
+  {
+    _heap.push_back (c);
+    place (c, _heap.size () - 1);
+    sift_up (c->_heap_index);
+  }
+
+  void
+  TimerService::remove (int i)
+  {
+    TimerClient* c = _heap[i];
+    TimerClient* last = _heap.back ();
+    _heap.pop_back ();
+    c->_heap_index = -1;
+    if (last == c)
+      return;
+    place (last, i);
+    sift_up (i);
+    sift_down (last->_heap_index);
+  }
+
+  void
+  TimerService::place (TimerClient* c, int i)
+  {
+    _heap[i] = c;
+    c->_heap_index = i;
+  }
+
+  void
+  TimerService::sift_up (int i)
+  {
+    TimerClient* c = _heap[i];
+    while (i > 0) {
+      int parent = (i - 1) / 2;
+      if (_heap[parent]->_deadline <= c->_deadline)
+        break;
+      place (_heap[parent], i);
+      i = parent;
+    }
+    place (c, i);
+  }
+
+  void
+  TimerService::sift_down (int i)
+  {
+    int n = _heap.size ();
+    TimerClient* c = _heap[i];
+    for (;;) {
+      int child = 2 * i + 1;
+      if (child >= n)
+        break;
+      if (child + 1 < n && _heap[child + 1]->_deadline < _heap[child]->_deadline)
+        child++;
+      if (c->_deadline <= _heap[child]->_deadline)
+        break;
+      place (_heap[child], i);
+      i = child;
+    }
+    place (c, i);
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djnn
+{
+  typedef std::chrono::steady_clock timer_clock_t;
+  typedef timer_clock_t::time_point timer_date_t;
+
+  /* something waiting for a deadline of the timer service */
+  class TimerClient
+  {
+  public:
+    TimerClient () : _heap_index (-1) {}
+    virtual ~TimerClient ();
+    /* called from the timer thread, with the exclusive access held and
+     * inside a graph update, once the deadline is reached */
+    virtual void do_timer () = 0;
+    bool is_scheduled () const { return _heap_index >= 0; }
+    timer_date_t deadline () const { return _deadline; }
+
+  private:
+    friend class TimerService;
+    int _heap_index;
+    timer_date_t _deadline;
+  };
+
+  /* A single thread waits for the earliest deadline of all the timers and
+   * clocks. The clients due at the same time are delivered together under
+   * one acquisition of the exclusive access, and the graph is executed
+   * once for all of them. The deadlines are kept in a binary heap indexed
+   * from the clients, so that a cancellation removes its entry at once. */
+  class TimerService
+  {
+  public:
+    static TimerService& instance ();
+    /* (re)schedule c at the given date, replacing its pending deadline if any */
+    void schedule (TimerClient* c, timer_date_t deadline);
+    void cancel (TimerClient* c);
+    int nb_scheduled ();
+
+  private:
+    TimerService ();
+    void run ();
+    void push (TimerClient* c);
+    void remove (int i);
+    void drop_from_batch (TimerClient* c);
+    void sift_up (int i);
+    void sift_down (int i);
+    void place (TimerClient* c, int i);
+
+    static TimerService* _instance;
+    static std::once_flag onceFlag;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<TimerClient*> _heap;
+    std::vector<TimerClient*> _batch;
+    std::thread* _thread;
+  };
+}
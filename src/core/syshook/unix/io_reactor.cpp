@@ -0,0 +1,203 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *
+ */
+
+#include "io_reactor.h"
+#include "iofd.h"
+#include "../syshook.h"
+#include "../../execution/graph.h"
+#include "../../error.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+namespace djnn {
+
+  IOReactor* IOReactor::_instance;
+  std::once_flag IOReactor::onceFlag;
+
+  IOReactor&
+  IOReactor::instance ()
+  {
+    std::call_once (IOReactor::onceFlag, [] () {
+      _instance = new IOReactor ();
+    });
+
+    return *(_instance);
+  }
+
+  IOReactor::IOReactor ()
+  : _next_id (1), _thread (nullptr)
+  {
+#if defined(__linux__)
+    _epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    if (_epoll_fd == -1)
+      warning (nullptr, "unable to create the epoll instance");
+#else
+    if (pipe (_wake_pipe) == -1)
+      warning (nullptr, "unable to create the wake-up pipe of the io reactor");
+    else
+      fcntl (_wake_pipe[0], F_SETFL, O_NONBLOCK);
+#endif
+  }
+
+  void
+  IOReactor::add (IOFD* iofd)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (iofd->_reactor_id != 0)
+      return;
+    unsigned long id = _next_id++;
+#if defined(__linux__)
+    struct epoll_event ev;
+    ev.events = EPOLLIN | (iofd->edge_triggered () ? EPOLLET : 0);
+    ev.data.u64 = id;
+    if (epoll_ctl (_epoll_fd, EPOLL_CTL_ADD, iofd->readfd (), &ev) == -1) {
+      warning (iofd, "unable to watch fd " + std::to_string (iofd->readfd ()));
+      return;
+    }
+#endif
+    iofd->_reactor_id = id;
+    _iofds[id] = iofd;
+    if (_thread == nullptr)
+      _thread = new std::thread (&IOReactor::run, this);
+#if !defined(__linux__)
+    else
+      wake_up ();
+#endif
+  }
+
+  void
+  IOReactor::remove (IOFD* iofd)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (iofd->_reactor_id == 0)
+      return;
+#if defined(__linux__)
+    /* fails harmlessly if the fd has already been closed, which removed it */
+    epoll_ctl (_epoll_fd, EPOLL_CTL_DEL, iofd->readfd (), nullptr);
+#else
+    wake_up ();
+#endif
+    _iofds.erase (iofd->_reactor_id);
+    iofd->_reactor_id = 0;
+  }
+
+  int
+  IOReactor::nb_fds ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    return _iofds.size ();
+  }
+
+#if defined(__linux__)
+  void
+  IOReactor::run ()
+  {
+    static const int max_events = 64;
+    struct epoll_event events[max_events];
+    std::vector<unsigned long> ready;
+    for (;;) {
+      int n = epoll_wait (_epoll_fd, events, max_events, -1); // blocking call
+      if (n == -1) {
+        if (errno == EINTR)
+          continue;
+        warning (nullptr, "error waiting for fds");
+        return;
+      }
+      ready.clear ();
+      for (int i = 0; i < n; i++)
+        ready.push_back (events[i].data.u64);
+      deliver (ready);
+    }
+  }
+#else
+  void
+  IOReactor::wake_up ()
+  {
+    char c = 0;
+    if (write (_wake_pipe[1], &c, 1) == -1 && errno != EAGAIN)
+      warning (nullptr, "unable to wake up the io reactor");
+  }
+
+  /* poll has no edge-triggered mode: every IOFD is level-triggered here */
+  void
+  IOReactor::run ()
+  {
+    std::vector<struct pollfd> fds;
+    std::vector<unsigned long> ids, ready;
+    for (;;) {
+      fds.clear ();
+      ids.clear ();
+      fds.push_back ({ _wake_pipe[0], POLLIN, 0 });
+      {
+        std::lock_guard<std::mutex> lock (_mutex);
+        for (auto& e : _iofds) {
+          fds.push_back ({ e.second->readfd (), POLLIN, 0 });
+          ids.push_back (e.first);
+        }
+      }
+      int n = poll (fds.data (), fds.size (), -1); // blocking call
+      if (n == -1) {
+        if (errno == EINTR)
+          continue;
+        warning (nullptr, "error waiting for fds");
+        return;
+      }
+      if (fds[0].revents) {
+        char buf[64];
+        while (read (_wake_pipe[0], buf, sizeof (buf)) > 0);
+      }
+      ready.clear ();
+      for (size_t i = 1; i < fds.size (); i++)
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+          ready.push_back (ids[i - 1]);
+      if (!ready.empty ())
+        deliver (ready);
+    }
+  }
+#endif
+
+  void
+  IOReactor::deliver (const std::vector<unsigned long>& ready)
+  {
+    djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
+    {
+      GraphUpdate update; // executing once at the end of the block
+      for (auto id : ready) {
+        IOFD* iofd;
+        {
+          /* looked up at the last moment: a previous fd may have removed this one */
+          std::lock_guard<std::mutex> lock (_mutex);
+          auto it = _iofds.find (id);
+          if (it == _iofds.end ())
+            continue;
+          iofd = it->second;
+        }
+        try {
+          iofd->_readable->activation (); // propagating
+        } catch (std::exception& e) {
+          warning (nullptr, e.what ());
+        }
+      }
+    }
+    djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Stéphane Conversy <stephane.conversy@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djnn {
+
+	class IOFD;
+
+	/* A single thread waiting for all the active IOFDs, with epoll on Linux
+	 * and poll elsewhere. The IOFDs found readable by one wait are delivered
+	 * together, under one acquisition of the exclusive access and one graph
+	 * execution. The IOFDs are registered under an id, so that one removed
+	 * while its event is pending is simply not found at delivery time. */
+	class IOReactor {
+	public:
+		static IOReactor& instance ();
+		void add (IOFD* iofd);
+		void remove (IOFD* iofd);
+		int nb_fds ();
+
+	private:
+		IOReactor ();
+		void run ();
+#if !defined(__linux__)
+		void wake_up ();
+#endif
+		void deliver (const std::vector<unsigned long>& ready);
+
+		static IOReactor* _instance;
+		static std::once_flag onceFlag;
+		std::mutex _mutex;
+		std::map<unsigned long, IOFD*> _iofds;
+		unsigned long _next_id;
+		std::thread* _thread;
+#if defined(__linux__)
+		int _epoll_fd;
+#else
+		int _wake_pipe[2]; // wakes up the poll to take the changes into account
+#endif
+	};
+}
@@ -13,54 +13,32 @@
  */
 
 #include "iofd.h"
-#include "../syshook.h"
-#include "../../error.h"
-#include <sys/select.h>
+#include "io_reactor.h"
+#include "../../tree/spike.h"
 
 namespace djnn {
 
   IOFD::IOFD(int readfd)
-  : _readfd(readfd)
+  : _readfd(readfd), _reactor_id (0), _edge_triggered (false)
   {
     _readable = new Spike (this, "readable");
   }
 
-  void
-  IOFD::activate ()
+  IOFD::~IOFD ()
   {
-    please_stop ();
-    start_thread ();
+    IOReactor::instance ().remove (this);
+    if (_readable) { delete _readable; _readable = nullptr;}
   }
 
   void
-  IOFD::deactivate ()
+  IOFD::activate ()
   {
-    please_stop ();
+    IOReactor::instance ().add (this);
   }
 
   void
-  IOFD::run ()
+  IOFD::deactivate ()
   {
-    set_please_stop (false);
-    try {
-      while (!get_please_stop ()) {
-        fd_set reads;
-        FD_ZERO (&reads);
-        FD_SET (_readfd, &reads);
-        int ret = select(_readfd+1, &reads, nullptr, nullptr, nullptr); // blocking call
-        if (ret == -1) {
-          warning (nullptr, "error reading fd");
-          return;
-        }
-        djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
-        if (!get_please_stop ()) {
-          _readable->activation (); // propagating
-         GRAPH_EXEC; // executing
-        }
-        djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
-      }
-    } catch (exception& e) {
-      warning (nullptr, e.what());
-    }
+    IOReactor::instance ().remove (this);
   }
 }
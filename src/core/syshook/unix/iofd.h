@@ -14,25 +14,30 @@
 
 #pragma once
 
-#include "../external_source.h"
 #include "../../tree/process.h"
 
 namespace djnn {
-	class IOFD : public Process, public ExternalSource {
+	class IOFD : public Process {
 	public:
 		IOFD(int readfd);
+		virtual ~IOFD();
 
 		int readfd() const { return _readfd; }
+		/* edge-triggered fds are only signaled when new data arrives, so the
+		 * reader must drain them; to be set before activation (Linux only) */
+		void set_edge_triggered (bool v) { _edge_triggered = v; }
+		bool edge_triggered () const { return _edge_triggered; }
 
 	protected:
 		// abstract_component
 		virtual void activate () override;
     	virtual void deactivate () override;
 	private:
-
-		void run () override;
+		friend class IOReactor;
 
 		Process *_readable;
 		int _readfd;
+		unsigned long _reactor_id;
+		bool _edge_triggered;
 	};
 }
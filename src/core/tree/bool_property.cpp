@@ -99,7 +99,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:boolproperty");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->text_attribute ("value", get_value () ? "true" : "false");
     AbstractSerializer::serializer->end ();
 
@@ -109,7 +109,7 @@ namespace djnn
   void
   BoolProperty::dump (int level)
   {
-    cout << (_parent ? _parent->find_component_name(this) : _name) << " [ " << value << " ]";
+    cout << (_parent ? _parent->find_component_name(this) : get_name ()) << " [ " << value << " ]";
   }
 
   Process* 
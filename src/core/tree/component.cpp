@@ -120,7 +120,7 @@ namespace djnn
       _children.erase (std::remove (_children.begin (), _children.end (), c), _children.end ());
       _symtable.erase (it);
     } else
-      std::cerr << "Warning: symbol " << name << " not found in Component " << _name << "\n";
+      std::cerr << "Warning: symbol " << name << " not found in Component " << get_name () << "\n";
   }
 
   void
@@ -172,7 +172,7 @@ namespace djnn
   void
   Container::print_children ()
   {
-    cout << _name << "'s children:\n";
+    cout << get_name () << "'s children:\n";
     for (auto c : _children) {
       cout << c->get_name () << endl;
     }
@@ -196,7 +196,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:component");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     for (auto c : _children)
         c->serialize (format);
@@ -254,7 +254,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:assignmentsequence");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     for (auto c : _children)
         c->serialize (format);
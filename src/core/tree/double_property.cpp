@@ -78,7 +78,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:doubleproperty");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->float_attribute ("value", get_value ());
     AbstractSerializer::serializer->end ();
 
@@ -88,7 +88,7 @@ namespace djnn
   void
   DoubleProperty::dump (int level)
   {
-    cout << (_parent ? _parent->find_component_name(this) : _name) << " [ " << value << " ]";
+    cout << (_parent ? _parent->find_component_name(this) : get_name ()) << " [ " << value << " ]";
   }
 
   Process* DoubleProperty::clone ()
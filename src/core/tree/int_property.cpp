@@ -71,7 +71,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:intproperty");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->int_attribute ("value", get_value ());
     AbstractSerializer::serializer->end ();
 
@@ -81,7 +81,7 @@ namespace djnn
   void
   IntProperty::dump (int level)
   {
-    cout << (_parent ? _parent->find_component_name(this) : _name) << " [ " << value << " ]";
+    cout << (_parent ? _parent->find_component_name(this) : get_name ()) << " [ " << value << " ]";
   }
 
   Process*
@@ -45,7 +45,7 @@ namespace djnn
   void
   AbstractList::dump (int level)
   {
-    cout << (_parent ? _parent->find_component_name(this) : _name)  << " [ index=" << _children.size () << " ]" << endl ;
+    cout << (_parent ? _parent->find_component_name(this) : get_name ())  << " [ index=" << _children.size () << " ]" << endl ;
 
     //FIXME: indent problem
     //for (auto c : _children)
@@ -96,7 +96,7 @@ namespace djnn
       goto label_error;
     }
     label_error: 
-      warning (this, "invalid specification '" + spec + "' for insertion in list '" + _name + "'");
+      warning (this, "invalid specification '" + spec + "' for insertion in list '" + get_name () + "'");
   }
 
   void
@@ -128,11 +128,11 @@ namespace djnn
         remove_child (c);
       } else {
          /* we have to dispay index as the API user index */
-         warning (this, "index " + std::to_string(index+1) + " is out of bound for list '" + _name + "'");
+         warning (this, "index " + std::to_string(index+1) + " is out of bound for list '" + get_name () + "'");
       }
     }
     catch (invalid_argument& arg) {
-      warning (this, "invalid child name '" + name + "' for list '" +_name + "'");
+      warning (this, "invalid child name '" + name + "' for list '" +get_name () + "'");
     }
   }
 
@@ -149,9 +149,6 @@ namespace djnn
 
   List::~List ()
   {
-    _added = nullptr;
-    _removed = nullptr;
-
     if (_added) {delete _added; _added = nullptr;}
     if (_removed) {delete _removed; _removed = nullptr;}
     if (_size) {delete _size; _size = nullptr;}
@@ -193,11 +190,11 @@ namespace djnn
             return c;
         } else {
           /* we have to dispay index as the API user index */
-          warning (this,  "index " + std::to_string(index+1) + " is out of bound for list \'" + _name + "\'");
+          warning (this,  "index " + std::to_string(index+1) + " is out of bound for list \'" + get_name () + "\'");
         }
       }
       catch (invalid_argument& arg) {
-        warning (this, "invalid child path '" + path + "' for list '" + _name + "'");
+        warning (this, "invalid child path '" + path + "' for list '" + get_name () + "'");
       }
     }
     return nullptr;
@@ -218,7 +215,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("core:list");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     for (auto c : _children)
         c->serialize (type);
@@ -282,9 +279,9 @@ namespace djnn
     _reset = new Spike (this, "reset");
     _iter = new RefProperty (this, "iter", nullptr);
     _index = new IntProperty (this, "index", 1);
-    _next_action = new IterAction (this, name + "_next_action", _list, _iter, _index, true);
-    _previous_action = new IterAction (this, name + "_previous_action", _list, _iter, _index, false);
-    _reset_action = new ResetAction (this, name + "_reset_action", _index);
+    _next_action = new IterAction (this, "next_action", _list, _iter, _index, true);
+    _previous_action = new IterAction (this, "previous_action", _list, _iter, _index, false);
+    _reset_action = new ResetAction (this, "reset_action", _index);
     _c_next = new Coupling (_next, ACTIVATION, _next_action, ACTIVATION);
     _c_next->disable ();
     _c_previous = new Coupling (_previous, ACTIVATION, _previous_action, ACTIVATION);
@@ -350,7 +347,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, type);
 
     AbstractSerializer::serializer->start ("core:bidirectionallistiterator");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::compute_path (get_parent (), _list, buf);
     AbstractSerializer::serializer->text_attribute ("list", buf);
 
@@ -0,0 +1,296 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+
+#include "node_pool.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+
+namespace djnn
+{
+  static const size_t granularity = 8;
+  static const size_t nb_size_classes = 64;
+  /* the chunks are aligned on their size, so that the chunk of a block is
+   * found from its address */
+  static const size_t chunk_size = 64 * 1024;
+
+  /* the chunks given back by the arenas are kept for the next ones and the
+   * pools, up to 16 MB: an aligned chunk costs a mmap */
+  static const size_t max_spare_chunks = 256;
+  static std::mutex spare_mutex;
+  static void* spare_chunks[max_spare_chunks];
+  static size_t nb_spare_chunks = 0;
+
+  /* at the start of every chunk: its arena, nullptr for those of the pools */
+  struct chunk_header_t
+  {
+    Arena* arena;
+    size_t unused; // keeps the blocks aligned on 16 bytes
+  };
+
+  /* the pools of a thread: zero-initialized, and never destroyed, so that
+   * nodes can still be freed while the program exits */
+  struct pools_t
+  {
+    void* free_lists[nb_size_classes + 1];
+    char* cur;
+    size_t left;
+    Arena* arena; // of the innermost ArenaScope
+    bool has_keeper;
+    bool ended;
+  };
+  static thread_local pools_t pools;
+
+  /* blocks left by the threads that ended, taken over by the others */
+  static std::mutex depot_mutex;
+  static void* depot[nb_size_classes + 1];
+  static std::atomic<bool> depot_filled (false);
+
+  /* hands the free blocks of a thread over to the depot when it ends */
+  struct pools_keeper_t
+  {
+    pools_keeper_t () { pools.has_keeper = true; }
+    ~pools_keeper_t ()
+    {
+      std::lock_guard<std::mutex> lock (depot_mutex);
+      for (size_t c = 1; c <= nb_size_classes; c++) {
+        void* head = pools.free_lists[c];
+        if (head == nullptr)
+          continue;
+        void* tail = head;
+        while (*(void**) tail != nullptr)
+          tail = *(void**) tail;
+        *(void**) tail = depot[c];
+        depot[c] = head;
+        pools.free_lists[c] = nullptr;
+      }
+      depot_filled = true;
+      pools.ended = true;
+    }
+  };
+  static thread_local pools_keeper_t keeper;
+
+  /* registers the keeper on the first use of the pools by the thread,
+   * whether it allocates or only frees blocks */
+  static inline void
+  keep_pools ()
+  {
+    if (!pools.has_keeper)
+      (void) &keeper;
+  }
+
+  static inline size_t
+  size_class_of (size_t size)
+  {
+    return (size + granularity - 1) / granularity;
+  }
+
+  static void*
+  aligned_chunk ()
+  {
+    void* c;
+#if defined(__WIN32__)
+    c = _aligned_malloc (chunk_size, chunk_size);
+#else
+    if (posix_memalign (&c, chunk_size, chunk_size) != 0)
+      c = nullptr;
+#endif
+    if (c == nullptr)
+      throw std::bad_alloc ();
+    return c;
+  }
+
+  static void
+  delete_chunk (void* c)
+  {
+#if defined(__WIN32__)
+    _aligned_free (c);
+#else
+    free (c);
+#endif
+  }
+
+  static chunk_header_t*
+  new_chunk (Arena* arena)
+  {
+    void* c = nullptr;
+    {
+      std::lock_guard<std::mutex> lock (spare_mutex);
+      if (nb_spare_chunks > 0)
+        c = spare_chunks[--nb_spare_chunks];
+    }
+    chunk_header_t* h = (chunk_header_t*) (c != nullptr ? c : aligned_chunk ());
+    h->arena = arena;
+    return h;
+  }
+
+  static inline chunk_header_t*
+  chunk_of (void* p)
+  {
+    return (chunk_header_t*) ((uintptr_t) p & ~(uintptr_t) (chunk_size - 1));
+  }
+
+  static void*
+  refill (size_t size_class)
+  {
+    if (depot_filled) {
+      std::lock_guard<std::mutex> lock (depot_mutex);
+      void* p = depot[size_class];
+      if (p != nullptr) {
+        /* a thread that has ended takes one block only, having no way to
+         * give the others back */
+        if (pools.ended)
+          depot[size_class] = *(void**) p;
+        else {
+          depot[size_class] = nullptr;
+          pools.free_lists[size_class] = *(void**) p;
+        }
+        return p;
+      }
+    }
+    size_t size = size_class * granularity;
+    if (pools.left < size) {
+      /* the chunks of the pools are never given back to the system */
+      pools.cur = (char*) new_chunk (nullptr) + sizeof (chunk_header_t);
+      pools.left = chunk_size - sizeof (chunk_header_t);
+    }
+    void* p = pools.cur;
+    pools.cur += size;
+    pools.left -= size;
+    return p;
+  }
+
+  void*
+  alloc_node (size_t size)
+  {
+    if (pools.arena != nullptr)
+      return pools.arena->allocate (size);
+    size_t size_class = size_class_of (size);
+    if (size_class > nb_size_classes) {
+      void* p = malloc (size_class * granularity);
+      if (p == nullptr)
+        throw std::bad_alloc ();
+      return p;
+    }
+    keep_pools ();
+    void* p = pools.free_lists[size_class];
+    if (p == nullptr)
+      return refill (size_class);
+    pools.free_lists[size_class] = *(void**) p;
+    return p;
+  }
+
+  void
+  free_node (void* p, size_t size)
+  {
+    if (p == nullptr)
+      return;
+    size_t size_class = size_class_of (size);
+    if (size_class > nb_size_classes) {
+      free (p);
+      return;
+    }
+    Arena* arena = chunk_of (p)->arena;
+    if (arena != nullptr) {
+      arena->release ();
+      return;
+    }
+    keep_pools ();
+    if (pools.ended) {
+      std::lock_guard<std::mutex> lock (depot_mutex);
+      *(void**) p = depot[size_class];
+      depot[size_class] = p;
+      depot_filled = true;
+    } else {
+      *(void**) p = pools.free_lists[size_class];
+      pools.free_lists[size_class] = p;
+    }
+  }
+
+  size_t
+  node_footprint (size_t size)
+  {
+    return size_class_of (size) * granularity;
+  }
+
+  Arena::Arena () :
+      _cur (nullptr), _left (0), _nb_live (0)
+  {
+  }
+
+  Arena::~Arena ()
+  {
+    if (_nb_live > 0)
+      std::cerr << "Warning: arena deleted while " << _nb_live << " of its nodes are still alive\n";
+    std::lock_guard<std::mutex> lock (spare_mutex);
+    for (auto c : _chunks) {
+      if (nb_spare_chunks < max_spare_chunks)
+        spare_chunks[nb_spare_chunks++] = c;
+      else
+        delete_chunk (c);
+    }
+  }
+
+  void*
+  Arena::allocate (size_t size)
+  {
+    size_t size_class = size_class_of (size);
+    /* the nodes too big for the pools are left to malloc, and freed one by one */
+    if (size_class > nb_size_classes) {
+      void* p = malloc (size_class * granularity);
+      if (p == nullptr)
+        throw std::bad_alloc ();
+      return p;
+    }
+    size = size_class * granularity;
+    if (_left < size) {
+      chunk_header_t* c = new_chunk (this);
+      _chunks.push_back (c);
+      _cur = (char*) c + sizeof (chunk_header_t);
+      _left = chunk_size - sizeof (chunk_header_t);
+    }
+    void* p = _cur;
+    _cur += size;
+    _left -= size;
+    _nb_live++;
+    return p;
+  }
+
+  size_t
+  Arena::reserved () const
+  {
+    return _chunks.size () * chunk_size;
+  }
+
+  ArenaScope::ArenaScope (Arena* arena) :
+      _previous (pools.arena)
+  {
+    pools.arena = arena;
+  }
+
+  ArenaScope::~ArenaScope ()
+  {
+    pools.arena = _previous;
+  }
+
+  Arena*
+  ArenaScope::current ()
+  {
+    return pools.arena;
+  }
+}
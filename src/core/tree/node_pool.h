@@ -0,0 +1,75 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace djnn {
+
+  /* allocation of the tree nodes (processes and couplings) from pools of
+   * blocks of the same size class, which keeps the small objects of a
+   * scene close to each other and recycles them without going through
+   * malloc. Each thread has its own pools and takes no lock: a block
+   * freed by another thread than the one that allocated it joins the
+   * pools of the former. The blocks carry no header, the size class being
+   * given again by the sized operator delete of the classes, and the
+   * arena, if any, by the chunk holding the block. */
+  void* alloc_node (size_t size);
+  void free_node (void* p, size_t size);
+  /* bytes actually taken by a node of the given size */
+  size_t node_footprint (size_t size);
+
+  /* Chunks of memory for the nodes of a whole subtree, e.g. a component
+   * loaded from XML, filled while an ArenaScope on the arena is alive.
+   * Deleting these nodes runs their destructors, so that they leave the
+   * graph and their couplings, but gives no memory back: it all goes at
+   * once when the arena is deleted, which must come after the nodes.
+   * An arena is filled by one thread at a time; its nodes can be deleted
+   * from any thread. */
+  class Arena {
+  public:
+    Arena ();
+    ~Arena ();
+    void* allocate (size_t size);
+    void release () { _nb_live--; }
+    int nb_live () const { return _nb_live; }
+    size_t reserved () const;
+  private:
+    Arena (const Arena&) = delete;
+    Arena & operator= (const Arena&) = delete;
+    std::vector<void*> _chunks;
+    char* _cur;
+    size_t _left;
+    std::atomic<int> _nb_live;
+  };
+
+  /* while an ArenaScope is alive, the processes and couplings created by
+   * the current thread are allocated in its arena, and must therefore go
+   * with the subtree; scopes can be nested */
+  class ArenaScope {
+  public:
+    ArenaScope (Arena* arena);
+    ~ArenaScope ();
+    static Arena* current ();
+  private:
+    ArenaScope (const ArenaScope&) = delete;
+    ArenaScope & operator= (const ArenaScope&) = delete;
+    Arena* _previous;
+  };
+
+}
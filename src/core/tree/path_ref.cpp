@@ -0,0 +1,54 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "path_ref.h"
+
+namespace djnn
+{
+  PathRef::PathRef (const std::string& path) :
+      _path (path), _last_from (nullptr), _last_result (nullptr), _last_epoch (0)
+  {
+    size_t start = 0;
+    while (start <= path.length ()) {
+      size_t found = path.find_first_of ('/', start);
+      if (found == std::string::npos)
+        found = path.length ();
+      if (found > start)
+        _segments.push_back (path.substr (start, found - start));
+      start = found + 1;
+    }
+  }
+
+  Process*
+  PathRef::find (Process* from)
+  {
+    if (from == nullptr)
+      return nullptr;
+    unsigned int epoch = SymTable::epoch ();
+    if (from == _last_from && epoch == _last_epoch)
+      return _last_result;
+    Process* p = from;
+    for (auto& s : _segments) {
+      p = p->find_component (s);
+      if (p == nullptr)
+        break;
+    }
+    /* find_component may have built children on the fly (e.g. the ui of a
+     * shape), so the epoch is read again */
+    _last_from = from;
+    _last_result = p;
+    _last_epoch = SymTable::epoch ();
+    return p;
+  }
+}
@@ -0,0 +1,42 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "process.h"
+
+#include <string>
+#include <vector>
+
+namespace djnn {
+
+  /* Path split once into its segments, for the paths looked up on every
+   * event. find (p) gives the same result as p->find_component (path),
+   * without parsing nor allocating: the segments are resolved one by one,
+   * and the last resolution is kept until the tree changes (see SymTable).
+   * A PathRef is meant to be used by a single thread. */
+  class PathRef {
+  public:
+    PathRef (const std::string& path);
+    Process* find (Process* from);
+    const std::string& path () const { return _path; }
+  private:
+    std::string _path;
+    std::vector<std::string> _segments;
+    Process* _last_from;
+    Process* _last_result;
+    unsigned int _last_epoch;
+  };
+
+}
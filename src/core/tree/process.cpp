@@ -13,18 +13,50 @@
  */
 
 #include "../execution/graph.h"
+#include "../execution/profiler.h"
 #include "process.h"
 #include "../control/coupling.h"
 #include "../uri.h"
 #include "../error.h"
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 namespace djnn
 {
   using namespace std;
 
   int Process::_nb_anonymous = 0;
+  SymTable::map_t SymTable::_empty;
+  std::atomic<unsigned int> SymTable::_epoch (0);
+
+  /* names are shared by all the processes that carry them (x, y, width...),
+   * with the number of those processes, and dropped with the last one */
+  static std::mutex names_mutex;
+  static std::unordered_map<string, int> names;
+  /* names of the anonymous processes, generated when first asked for */
+  static std::unordered_map<const Process*, string> generated_names;
+
+  static const string*
+  intern_name (const string& name)
+  {
+    std::lock_guard<std::mutex> lock (names_mutex);
+    auto it = names.find (name);
+    if (it == names.end ())
+      it = names.insert (std::make_pair (name, 0)).first;
+    it->second++;
+    return &it->first;
+  }
+
+  static void
+  release_name (const string* name)
+  {
+    std::lock_guard<std::mutex> lock (names_mutex);
+    auto it = names.find (*name);
+    if (it != names.end () && --it->second == 0)
+      names.erase (it);
+  }
 
   void
   alias_children (Process* p, Process* from)
@@ -69,40 +101,41 @@ namespace djnn
   Process::finalize ()
   {
     if (_parent != nullptr)
-      _parent->add_child (this, _name);
+      _parent->add_child (this, get_name ());
   }
 
   Process::Process (Process* parent, const string& name, bool model) :
-      _vertex (nullptr), _parent (parent), _state_dependency (nullptr), _source (nullptr), _data (nullptr), _activation_state (
-          deactivated), _model (model), _activation_flag (NONE), _has_couplings (false)
+      _vertex (nullptr), _name (name.length () > 0 ? intern_name (name) : nullptr), _dbg_location (Context::instance ()->location ()),
+      _has_generated_name (false), _parent (parent), _state_dependency (nullptr), _source (nullptr), _data (nullptr),
+      _activation_state (deactivated), _activation_flag (NONE), _cpnt_type (UNDEFINED), _model (model), _has_couplings (false),
+      _thread_safe (false), _main_thread_only (false)
   {
-    _name = name.length () > 0 ? name : "anonymous_" + to_string (++_nb_anonymous);
     if (_parent != nullptr)
       _state_dependency = _parent->_state_dependency;
-    _cpnt_type = UNDEFINED;
-    if (Context::instance ()->line () != -1) {
-      _dbg_info = std::string ("File: ") + Context::instance ()->filename () + " line: " + std::to_string (Context::instance ()->line ());
-    } else
-      _dbg_info = "non debug info";
   }
 
   Process::Process (bool model) :
-      _vertex (nullptr), _parent (nullptr), _state_dependency (nullptr), _source (nullptr), _data (nullptr), _activation_state (
-          deactivated), _model (model), _activation_flag (NONE), _has_couplings (false)
+      _vertex (nullptr), _name (nullptr), _dbg_location (Context::instance ()->location ()), _has_generated_name (false),
+      _parent (nullptr), _state_dependency (nullptr), _source (nullptr), _data (nullptr), _activation_state (deactivated),
+      _activation_flag (NONE), _cpnt_type (UNDEFINED), _model (model), _has_couplings (false), _thread_safe (false), _main_thread_only (false)
   {
-    _name = "anonymous_" + to_string (++_nb_anonymous);
-
-    _cpnt_type = UNDEFINED;
-    if (Context::instance ()->line () != -1) {
-      _dbg_info = std::string ("File: ") + Context::instance ()->filename () + " line: " + std::to_string (Context::instance ()->line ());
-    } else
-      _dbg_info = "non debug info";
   }
 
   Process::~Process ()
   {
-    if (_vertex != nullptr)
-      _vertex->invalidate ();
+    if (_vertex != nullptr) {
+      _vertex->set_process_deleted ();
+      Graph::instance ().remove_vertex (_vertex);
+    }
+    if (Profiler::instance ().is_enabled ())
+      Profiler::instance ().retire (this);
+    SymTable::touch ();
+    if (_name != nullptr)
+      release_name (_name);
+    if (_has_generated_name) {
+      std::lock_guard<std::mutex> lock (names_mutex);
+      generated_names.erase (this);
+    }
   }
 
   bool
@@ -130,15 +163,13 @@ namespace djnn
   void
   Process::remove_activation_coupling (Coupling* c)
   {
-    _activation_couplings.erase (std::remove (_activation_couplings.begin (), _activation_couplings.end (), c),
-                                 _activation_couplings.end ());
+    _activation_couplings.remove (c);
   }
 
   void
   Process::remove_deactivation_coupling (Coupling* c)
   {
-    _deactivation_couplings.erase (std::remove (_deactivation_couplings.begin (), _deactivation_couplings.end (), c),
-                                   _deactivation_couplings.end ());
+    _deactivation_couplings.remove (c);
   }
 
   Process*
@@ -231,25 +262,25 @@ namespace djnn
   void
   Process::notify_activation ()
   {
-    couplings_t couplings_cpy = couplings_t (_activation_couplings);
-    for (auto coupling : couplings_cpy) {
-      coupling->propagateActivation ();
-    }
+    if (_activation_couplings.empty () || Graph::defer_propagation (this, ACTIVATION))
+      return;
+    _activation_couplings.propagate_activation ();
   }
 
   void
   Process::notify_deactivation ()
   {
-    couplings_t couplings_cpy = couplings_t (_deactivation_couplings);
-    for (auto coupling : couplings_cpy) {
-      coupling->propagateDeactivation ();
-    }
+    if (_deactivation_couplings.empty () || Graph::defer_propagation (this, DEACTIVATION))
+      return;
+    _deactivation_couplings.propagate_deactivation ();
   }
 
   void
   Process::set_activation_flag (int flag)
   {
     _activation_flag = flag;
+    if (flag != NONE && _vertex != nullptr)
+      Graph::instance ().schedule_activation (_vertex);
   }
 
   int
@@ -261,14 +292,14 @@ namespace djnn
   void
   Process::add_activation_coupling (Coupling* c)
   {
-    _activation_couplings.push_back (c);
+    _activation_couplings.add (c);
     _has_couplings = true;
   }
 
   void
   Process::add_deactivation_coupling (Coupling* c)
   {
-    _deactivation_couplings.push_back (c);
+    _deactivation_couplings.add (c);
     _has_couplings = true;
   }
 
@@ -276,7 +307,7 @@ namespace djnn
   Process::add_symbol (const string &name, Process* c)
   {
     /* if ((_symtable.insert (std::pair<string, Process*> (name, c))).second == false) {
-     cerr << "Duplicate name " << name << " in component " << _name << endl;
+     cerr << "Duplicate name " << name << " in component " << get_name () << endl;
      }*/
     _symtable[name] = c;
   }
@@ -337,10 +368,40 @@ namespace djnn
     return _parent;
   }
 
+  void
+  Process::set_parent (Process* p)
+  {
+    _parent = p;
+    if (_main_thread_only && _parent != nullptr)
+      _parent->set_main_thread_only ();
+  }
+
+  void
+  Process::set_main_thread_only ()
+  {
+    /* the ancestors of a flagged process are already flagged */
+    for (Process* p = this; p != nullptr && !p->_main_thread_only; p = p->_parent)
+      p->_main_thread_only = true;
+  }
+
   const string&
   Process::get_name () const
   {
-    return _name;
+    if (_name != nullptr)
+      return *_name;
+    std::lock_guard<std::mutex> lock (names_mutex);
+    auto it = generated_names.find (this);
+    if (it == generated_names.end ()) {
+      it = generated_names.insert (std::make_pair (this, "anonymous_" + to_string (++_nb_anonymous))).first;
+      _has_generated_name = true;
+    }
+    return it->second;
+  }
+
+  string
+  Process::debug_info ()
+  {
+    return Context::instance ()->location_info (_dbg_location);
   }
 
   int
@@ -352,13 +413,13 @@ namespace djnn
   couplings_t
   Process::get_activation_couplings ()
   {
-    return _activation_couplings;
+    return _activation_couplings.to_vector ();
   }
 
   couplings_t
   Process::get_deactivation_couplings ()
   {
-    return _deactivation_couplings;
+    return _deactivation_couplings.to_vector ();
   }
 
   void
@@ -389,7 +450,7 @@ namespace djnn
   void
   Process::dump (int level)
   {
-    cout << (_parent ? _parent->find_component_name(this) : _name) << ": ";
+    cout << (_parent ? _parent->find_component_name(this) : get_name ()) << ": ";
 
     /* check if the component is empty - should be ?*/
     if (_symtable.empty ()) {
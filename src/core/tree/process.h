@@ -16,6 +16,9 @@
 
 #include "../core_types.h"
 #include "../execution/graph.h"
+#include "../control/coupling_list.h"
+#include "node_pool.h"
+#include <atomic>
 #include <vector>
 #include <map>
 #include <string>
@@ -46,12 +49,43 @@ namespace djnn {
 
   typedef vector<Coupling*> couplings_t;
 
+  /* children of a process: most processes have none, so the map
+   * is only allocated on the first insertion. Any change to any symbol
+   * table, or the deletion of any process, moves the tree epoch forward,
+   * which invalidates the PathRef caches */
+  class SymTable
+  {
+  public:
+    typedef map<string, Process*> map_t;
+    typedef map_t::iterator iterator;
+    SymTable () : _map (nullptr) {}
+    ~SymTable () { delete _map; }
+    iterator begin () { return get ().begin (); }
+    iterator end () { return get ().end (); }
+    iterator find (const string& key) { return get ().find (key); }
+    void erase (iterator it) { _map->erase (it); touch (); }
+    bool empty () const { return _map == nullptr || _map->empty (); }
+    Process*& operator[] (const string& key) { if (_map == nullptr) _map = new map_t; touch (); return (*_map)[key]; }
+    const map_t& content () const { return _map ? *_map : _empty; }
+    static unsigned int epoch () { return _epoch.load (std::memory_order_relaxed); }
+    static void touch () { _epoch.fetch_add (1, std::memory_order_relaxed); }
+  private:
+    SymTable (const SymTable&) = delete;
+    SymTable & operator= (const SymTable&) = delete;
+    map_t& get () { return _map ? *_map : _empty; }
+    static map_t _empty;
+    static std::atomic<unsigned int> _epoch;
+    map_t* _map;
+  };
+
   class Process
   {
   public:
     Process (Process *parent, const string& name, bool model = false);
     Process (bool model = false);
     virtual ~Process ();
+    static void* operator new (size_t size) { return alloc_node (size); }
+    static void operator delete (void* p, size_t size) { free_node (p, size); }
     void finalize ();
     bool is_model ();
     virtual void activation ();
@@ -74,7 +108,7 @@ namespace djnn {
     virtual string find_component_name (Process* child);
     void add_symbol (const string &name, Process* c);
     void remove_symbol (const string& name);
-    map<string, Process*> symtable () { return _symtable; }
+    map<string, Process*> symtable () { return _symtable.content (); }
 
     virtual void add_child (Process* c, const string& name);
     virtual void remove_child (Process* c);
@@ -89,7 +123,7 @@ namespace djnn {
     void set_vertex (Vertex *v) { _vertex = v; }
     Vertex* vertex () { return _vertex; };
     Process* get_parent ();
-    void set_parent (Process* p) { _parent = p; }
+    void set_parent (Process* p);
     const string& get_name () const;
 
     int get_cpnt_type ();
@@ -97,6 +131,17 @@ namespace djnn {
     couplings_t get_deactivation_couplings ();
     bool has_coupling () { return _has_couplings; } ;
 
+    /* the graph worker threads only run the thread-safe processes (see
+     * Graph::set_parallel_execution): their activation must neither change
+     * the tree or the graph nor touch anything shared with other processes.
+     * The couplings it triggers are propagated afterwards, on the main thread */
+    void set_thread_safe (bool v) { _thread_safe = v; }
+    bool is_thread_safe () const { return _thread_safe && !_main_thread_only; }
+    /* a process that must run on the main thread, and so do all its ancestors,
+     * whose activation reaches it, even if they were declared thread-safe */
+    void set_main_thread_only ();
+    bool is_main_thread_only () const { return _main_thread_only; }
+
     void set_source (Process* src);
     Process* get_activation_source ();
     void set_data (Process* data);
@@ -104,17 +149,21 @@ namespace djnn {
 
     virtual void dump (int level=0);
 
-    string debug_info () { return _dbg_info; }
+    string debug_info ();
     // Actions
     virtual void draw () {};
-    virtual void serialize (const string& format) { cout << "serialize is not yet implemented for '" << _name << "'" << endl; }
-    virtual Process* clone () { cout << "clone not implemented for " << _name << "\n"; return nullptr; };
+    virtual void serialize (const string& format) { cout << "serialize is not yet implemented for '" << get_name () << "'" << endl; }
+    virtual Process* clone () { cout << "clone not implemented for " << get_name () << "\n"; return nullptr; };
   private:
     static int _nb_anonymous;
-    couplings_t _activation_couplings;
-    couplings_t _deactivation_couplings;
+    CouplingList _activation_couplings;
+    CouplingList _deactivation_couplings;
     Vertex *_vertex;
-    string _dbg_info;
+    /* interned, nullptr for an anonymous process whose name is generated on demand */
+    const string* _name;
+    /* see Context::location */
+    int _dbg_location;
+    mutable bool _has_generated_name;
 
   protected:
     virtual void pre_activate ();
@@ -125,15 +174,16 @@ namespace djnn {
     virtual void deactivate () = 0;
     virtual void post_deactivate ();
 
-    map<string, Process*> _symtable;
-    string _name;
+    SymTable _symtable;
     Process *_parent, *_state_dependency;
     Process* _source, *_data;
     activation_state _activation_state;
-    bool _model;
     int _activation_flag;
     int _cpnt_type;
+    bool _model;
     bool _has_couplings;
+    bool _thread_safe;
+    bool _main_thread_only;
   };
 
   void
@@ -156,7 +156,7 @@ namespace djnn
     AbstractSerializer::pre_serialize (this, type);
 
     AbstractSerializer::serializer->start ("core:set");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
 
     std::map<std::string, Process*>::iterator it;
     for (it = _symtable.begin (); it != _symtable.end (); ++it)
@@ -65,7 +65,7 @@ namespace djnn
     AbstractSerializer::pre_serialize(this, format);
 
     AbstractSerializer::serializer->start ("core:textproperty");
-    AbstractSerializer::serializer->text_attribute ("id", _name);
+    AbstractSerializer::serializer->text_attribute ("id", get_name ());
     AbstractSerializer::serializer->text_attribute ("value", get_value ());
     AbstractSerializer::serializer->end ();
 
@@ -74,7 +74,7 @@ namespace djnn
 
   void
   TextProperty::dump (int level) {
-    cout << (_parent ? _parent->find_component_name(this) : _name) << " [ " << value << " ]" ;
+    cout << (_parent ? _parent->find_component_name(this) : get_name ()) << " [ " << value << " ]" ;
   }
 
   Process* 
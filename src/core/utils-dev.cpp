@@ -37,6 +37,12 @@ namespace djnn {
 #endif
   }
 
+  double elapsed_ms (const struct timespec &since) {
+    struct timespec now;
+    get_monotonic_time (&now);
+    return (now.tv_sec - since.tv_sec) * 1e3 + (now.tv_nsec - since.tv_nsec) * 1e-6;
+  }
+
 static struct timespec before;
 static struct timespec after;
 static int init = 0;
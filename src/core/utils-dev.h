@@ -19,6 +19,8 @@
 
 namespace djnn {
   void get_monotonic_time (struct timespec *ts);
+  /* milliseconds elapsed since a date given by get_monotonic_time */
+  double elapsed_ms (const struct timespec &since);
   void t1 ();
   double t2 (const std::string &msg = "");
 }
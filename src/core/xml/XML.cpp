@@ -101,6 +101,13 @@ namespace djnn {
     };
   }
 
+  Process*
+  XML::djnLoadFromXML (const string &uri, Arena* arena)
+  {
+    ArenaScope scope (arena);
+    return djnLoadFromXML (uri);
+  }
+
   Process*
   XML::djnParseXML (FILE* f)
   {
@@ -68,6 +68,8 @@ namespace djnn
   class XML {
   public:
     static Process* djnLoadFromXML (const std::string &uri);
+    /* the loaded tree is allocated in arena, see node_pool.h */
+    static Process* djnLoadFromXML (const std::string &uri, Arena* arena);
     static Process* djnParseXML (FILE* f);
     static int djn_RegisterXMLParser (const string &uri, djn_XMLTagLookupProc l, const char* f);
     static void clear_xml_parser ();
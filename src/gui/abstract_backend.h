@@ -28,7 +28,13 @@ namespace djnn
   class AbstractBackend
   {
   public:
-    AbstractBackend () : _window (nullptr) {
+    /* a frame either repaints everything, or first goes through the tree
+     * to collect the boxes of the shapes that changed, then repaints only
+     * what lies in the damage of the window. The color picking view is
+     * drawn apart, by a picking pass limited to the pick damage */
+    enum damage_pass_t { FULL_REPAINT, BOUNDS_PASS, PARTIAL_REPAINT, PICKING_PASS };
+
+    AbstractBackend () : _window (nullptr), _damage_pass (FULL_REPAINT) {
     }
 
     virtual
@@ -51,6 +57,39 @@ namespace djnn
       return _window;
     }
 
+    void
+    set_damage_pass (damage_pass_t p)
+    {
+      _damage_pass = p;
+    }
+
+    damage_pass_t
+    damage_pass ()
+    {
+      return _damage_pass;
+    }
+
+    /* called by the backends with the box of a shape in window coordinates,
+     * once it is known and before anything is drawn */
+    bool
+    must_paint (AbstractGShape *s, double x, double y, double w, double h)
+    {
+      switch (_damage_pass)
+        {
+        case BOUNDS_PASS:
+          s->update_box (x, y, w, h, _window->damage (), _window->pick_damage ());
+          return false;
+        case PARTIAL_REPAINT:
+          return _window->damage ().intersects (x, y, w, h);
+        case PICKING_PASS:
+          return _window->pick_damage ().intersects (x, y, w, h);
+        default:
+          /* the damage is the whole window, the pick damage is still needed */
+          s->update_box (x, y, w, h, _window->damage (), _window->pick_damage ());
+          return true;
+        }
+    }
+
     // shapes
     virtual void
     draw_rect (Rectangle *s, double x, double y, double w, double h, double rx, double ry)
@@ -279,5 +318,6 @@ namespace djnn
 
   protected:
     Window *_window;
+    damage_pass_t _damage_pass;
   };
 }
@@ -13,6 +13,7 @@
  */
 
 #include "abstract_gobj.h"
+#include "shapes/shapes.h"
 
 namespace djnn
 {
@@ -23,6 +24,7 @@ namespace djnn
 
   UpdateDrawing::UpdateDrawing ()
   {
+    set_main_thread_only ();
     _auto_refresh = new BoolProperty (this, "auto_refresh", true);
     _draw_sync = new Spike (this, "draw_sync");
     _damaged = new UndelayedSpike (this, "damaged");
@@ -85,6 +87,35 @@ namespace djnn
     }
   }
 
+  /* the graphical object holding a property that changed, going through
+   * the internal lists of points and gradient stops */
+  static AbstractGObj*
+  changed_gobj (Process *src)
+  {
+    AbstractGObj *g = nullptr;
+    for (Process *p = src; p != nullptr; p = p->get_parent ()) {
+      AbstractGObj *o = dynamic_cast<AbstractGObj*> (p);
+      if (o != nullptr)
+        g = o;
+      else if (g != nullptr && dynamic_cast<AbstractGObj*> (p->get_parent ()) == nullptr)
+        break;
+    }
+    return g;
+  }
+
+  void
+  UpdateDrawing::UndelayedSpike::coupling_activation_hook ()
+  {
+    Window *frame = dynamic_cast<Window*> (get_data ());
+    AbstractGObj *g = changed_gobj (get_activation_source ());
+    if (g != nullptr)
+      g->damage ();
+    if (frame && !frame->refresh ()) {
+      _ud->add_window_for_refresh (frame);
+    }
+    notify_activation ();
+  }
+
   void
   UpdateDrawing::init ()
   {
@@ -136,6 +167,7 @@ namespace djnn
         return;
       }
     }
+    damage ();
     UpdateDrawing::instance ()->add_window_for_refresh (_frame);
     UpdateDrawing::instance ()->get_damaged ()->notify_activation ();
   }
@@ -144,8 +176,59 @@ namespace djnn
   AbstractGObj::deactivate ()
   {
     if (_frame != nullptr) {
+      AbstractGShape *s = dynamic_cast<AbstractGShape*> (this);
+      if (s != nullptr)
+        s->clear_box (_frame->damage (), _frame->pick_damage ());
+      damage ();
       UpdateDrawing::instance ()->add_window_for_refresh (_frame);
       UpdateDrawing::instance ()->get_damaged ()->notify_activation ();
     }
   }
+
+  static void
+  damage_all (Process *p)
+  {
+    AbstractGShape *s = dynamic_cast<AbstractGShape*> (p);
+    if (s != nullptr) {
+      s->set_damaged ();
+      return;
+    }
+    Container *c = dynamic_cast<Container*> (p);
+    if (c != nullptr) {
+      for (auto child : c->children ())
+        damage_all (child);
+    }
+  }
+
+  void
+  AbstractGObj::damage ()
+  {
+    /* a point changes the geometry of its path or polygon */
+    AbstractGObj *g = changed_gobj (this);
+    if (g != this) {
+      g->damage ();
+      return;
+    }
+    Path *path = dynamic_cast<Path*> (this);
+    if (path != nullptr)
+      path->set_invalid_cache (true);
+    Poly *poly = dynamic_cast<Poly*> (this);
+    if (poly != nullptr)
+      poly->set_invalid_cache (true);
+    AbstractGShape *s = dynamic_cast<AbstractGShape*> (this);
+    if (s != nullptr && dynamic_cast<RectangleClip*> (s) == nullptr && dynamic_cast<PathClip*> (s) == nullptr) {
+      s->set_damaged ();
+      return;
+    }
+    Container *c = dynamic_cast<Container*> (_parent);
+    if (c == nullptr)
+      return;
+    bool after = false;
+    for (auto child : c->children ()) {
+      if (after)
+        damage_all (child);
+      else if (child == this)
+        after = true;
+    }
+  }
 }
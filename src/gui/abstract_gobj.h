@@ -35,15 +35,21 @@ namespace djnn
     AbstractGObj () : Process(), _frame (nullptr) {
       if (!gui_initialized) warning (this, "Module GUI not initialized");
       _cpnt_type = GOBJ;
+      set_main_thread_only ();
     }
     AbstractGObj (Process *p, const std::string& n) : Process (p, n), _frame (nullptr) {
       if (!gui_initialized)  warning (this, "Module GUI not initialized");
       _cpnt_type = GOBJ;
+      set_main_thread_only ();
     }
     virtual ~AbstractGObj () {};
     Window*& frame () { return _frame; }
     void activate () override;
     void deactivate () override;
+    /* marks the shapes a change of this object makes to repaint: itself if
+     * it is a shape, otherwise the shapes drawn after it in its component,
+     * which its style, transformation or clip applies to */
+    void damage ();
   protected:
     Window *_frame;
   };
@@ -77,12 +83,7 @@ namespace djnn
       void post_activate () override {_activation_state = deactivated;}
       void activate () override {};
       void deactivate () override {};
-      void coupling_activation_hook () override {
-        Window *frame = dynamic_cast<Window*> (get_data ());
-        if (frame && !frame->refresh ()) {
-          _ud->add_window_for_refresh (frame);
-         }
-        notify_activation (); };
+      void coupling_activation_hook () override;
     private:
       UpdateDrawing* _ud;
     };
@@ -94,30 +94,173 @@ namespace djnn
     move->add_symbol ("y", my);
     move->add_symbol ("local_x", local_x);
     move->add_symbol ("local_y", local_y);
-    _matrix = new Homography (this, "matrix", 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
-    _matrix->set_state (activated);
-    _inverted_matrix = new Homography (this, "inverted_matrix", 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
-    _inverted_matrix->set_state (activated);
     _has_ui = true;
+    /* to be drawn in the color picking view by the next frame */
+    _damaged = true;
   }
 
   AbstractGShape::AbstractGShape () :
-      AbstractGObj (), _matrix (nullptr), _inverted_matrix (nullptr), _has_ui (false)
+      AbstractGObj (), _matrix (nullptr), _inverted_matrix (nullptr), _has_inverse (false), _box_x (0), _box_y (0), _box_w (0), _box_h (0), _has_box (false), _damaged (true), _has_ui (false)
   {
     _origin_x = new DoubleProperty (this, "origin_x", 0);
     _origin_y = new DoubleProperty (this, "origin_y", 0);
+    _ctm[0] = _ctm[3] = 1;
+    _ctm[1] = _ctm[2] = _ctm[4] = _ctm[5] = 0;
   }
 
   AbstractGShape::AbstractGShape (Process *p, const std::string& n) :
-      AbstractGObj (p, n), _matrix (nullptr), _inverted_matrix (nullptr), _has_ui (false)
+      AbstractGObj (p, n), _matrix (nullptr), _inverted_matrix (nullptr), _has_inverse (false), _box_x (0), _box_y (0), _box_w (0), _box_h (0), _has_box (false), _damaged (true), _has_ui (false)
   {
     _origin_x = new DoubleProperty (this, "origin_x", 0);
     _origin_y = new DoubleProperty (this, "origin_y", 0);
+    _ctm[0] = _ctm[3] = 1;
+    _ctm[1] = _ctm[2] = _ctm[4] = _ctm[5] = 0;
+  }
+
+  void
+  AbstractGShape::set_ctm (double a, double b, double c, double d, double e, double f)
+  {
+    if (a == _ctm[0] && b == _ctm[1] && c == _ctm[2] && d == _ctm[3] && e == _ctm[4] && f == _ctm[5])
+      return;
+    _ctm[0] = a;
+    _ctm[1] = b;
+    _ctm[2] = c;
+    _ctm[3] = d;
+    _ctm[4] = e;
+    _ctm[5] = f;
+    _has_inverse = false;
+    if (_matrix != nullptr)
+      update_matrices ();
+  }
+
+  /* computed when first needed after a change */
+  void
+  AbstractGShape::update_inverse ()
+  {
+    if (_has_inverse)
+      return;
+    double det = _ctm[0] * _ctm[3] - _ctm[1] * _ctm[2];
+    if (det == 0) {
+      /* as Qt does for a matrix that cannot be inverted */
+      _inverse[0] = _inverse[3] = 1;
+      _inverse[1] = _inverse[2] = _inverse[4] = _inverse[5] = 0;
+    } else {
+      _inverse[0] = _ctm[3] / det;
+      _inverse[1] = -_ctm[1] / det;
+      _inverse[2] = -_ctm[2] / det;
+      _inverse[3] = _ctm[0] / det;
+      _inverse[4] = -(_inverse[0] * _ctm[4] + _inverse[2] * _ctm[5]);
+      _inverse[5] = -(_inverse[1] * _ctm[4] + _inverse[3] * _ctm[5]);
+    }
+    _has_inverse = true;
+  }
+
+  void
+  AbstractGShape::window_to_local (double x, double y, double &lx, double &ly)
+  {
+    update_inverse ();
+    lx = _inverse[0] * x + _inverse[2] * y + _inverse[4];
+    ly = _inverse[1] * x + _inverse[3] * y + _inverse[5];
+  }
+
+  void
+  AbstractGShape::local_to_window (double x, double y, double &wx, double &wy)
+  {
+    wx = _ctm[0] * x + _ctm[2] * y + _ctm[4];
+    wy = _ctm[1] * x + _ctm[3] * y + _ctm[5];
+  }
+
+  Process*
+  AbstractGShape::matrix ()
+  {
+    if (_matrix == nullptr)
+      init_matrices ();
+    return _matrix;
+  }
+
+  Process*
+  AbstractGShape::inverted_matrix ()
+  {
+    if (_inverted_matrix == nullptr)
+      init_matrices ();
+    return _inverted_matrix;
+  }
+
+  void
+  AbstractGShape::init_matrices ()
+  {
+    _matrix = new Homography (this, "matrix", 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+    _matrix->set_state (activated);
+    _inverted_matrix = new Homography (this, "inverted_matrix", 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+    _inverted_matrix->set_state (activated);
+    update_matrices ();
+  }
+
+  static void
+  set_homography (Homography *h, double a, double b, double c, double d, double e, double f)
+  {
+    h->_m11->set_value (a, false);
+    h->_m12->set_value (c, false);
+    h->_m14->set_value (e, false);
+    h->_m21->set_value (b, false);
+    h->_m22->set_value (d, false);
+    h->_m24->set_value (f, false);
+  }
+
+  /* the other coefficients of a 2D transformation stay as they were made */
+  void
+  AbstractGShape::update_matrices ()
+  {
+    set_homography (dynamic_cast<Homography*> (_matrix), _ctm[0], _ctm[1], _ctm[2], _ctm[3], _ctm[4], _ctm[5]);
+    update_inverse ();
+    set_homography (dynamic_cast<Homography*> (_inverted_matrix), _inverse[0], _inverse[1], _inverse[2], _inverse[3],
+                    _inverse[4], _inverse[5]);
+  }
+
+  void
+  AbstractGShape::set_box (double x, double y, double w, double h)
+  {
+    _box_x = x;
+    _box_y = y;
+    _box_w = w;
+    _box_h = h;
+    _has_box = true;
+    _damaged = false;
+  }
+
+  void
+  AbstractGShape::update_box (double x, double y, double w, double h, DamageRegion &d, DamageRegion &pick)
+  {
+    if (!_damaged && _has_box && x == _box_x && y == _box_y && w == _box_w && h == _box_h)
+      return;
+    if (_has_box)
+      d.add (_box_x, _box_y, _box_w, _box_h);
+    d.add (x, y, w, h);
+    if (_has_ui) {
+      if (_has_box)
+        pick.add (_box_x, _box_y, _box_w, _box_h);
+      pick.add (x, y, w, h);
+    }
+    set_box (x, y, w, h);
+  }
+
+  void
+  AbstractGShape::clear_box (DamageRegion &d, DamageRegion &pick)
+  {
+    if (_has_box) {
+      d.add (_box_x, _box_y, _box_w, _box_h);
+      if (_has_ui)
+        pick.add (_box_x, _box_y, _box_w, _box_h);
+    }
+    _has_box = false;
   }
 
   Process*
   AbstractGShape::find_component (const string &path)
   {
+    string name = path.substr (0, path.find_first_of ('/'));
+    if (_matrix == nullptr && (name == "matrix" || name == "inverted_matrix"))
+      init_matrices ();
     if (_has_ui)
       return Process::find_component (path);
     else {
@@ -143,6 +286,8 @@ namespace djnn
   {
     delete _origin_x;
     delete _origin_y;
+    if (_matrix) {delete _matrix; _matrix = nullptr;}
+    if (_inverted_matrix) {delete _inverted_matrix; _inverted_matrix = nullptr;}
     if (_has_ui) {
       Process* press = find_component ("press");
       Process* release = find_component ("release");
@@ -156,8 +301,6 @@ namespace djnn
       press->remove_symbol ("y");
       move->remove_symbol ("x");
       move->remove_symbol ("y");
-      delete _matrix;
-      delete _inverted_matrix;
       delete press;
       delete release;
       delete move;
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "abstract_gobj.h"
+#include "damage.h"
 
 #include "../core/tree/double_property.h"
 #include "../core/tree/process.h"
@@ -41,18 +42,43 @@ namespace djnn
     AbstractGShape (Process *p, const std::string& n);
     AbstractGShape ();
     virtual ~AbstractGShape ();
-    Process* matrix () { return _matrix; }
-    Process* inverted_matrix () { return _inverted_matrix; }
+    /* the Homography views of the transformation, made when first asked for */
+    Process* matrix ();
+    Process* inverted_matrix ();
+    /* the transformation from the shape to the window, set when it is drawn:
+     * x' = a x + c y + e, y' = b x + d y + f */
+    void set_ctm (double a, double b, double c, double d, double e, double f);
+    const double* ctm () { return _ctm; }
+    /* between the window and the coordinates of the shape, origin excluded */
+    void window_to_local (double x, double y, double &lx, double &ly);
+    void local_to_window (double x, double y, double &wx, double &wy);
     void set_origin (double x, double y) { _origin_x->set_value (x, true); _origin_y->set_value (y, true); }
     DoubleProperty* origin_x () { return _origin_x; }
     DoubleProperty* origin_y () { return _origin_y; }
     bool has_ui () { return _has_ui; }
     Process* find_component (const string &n) override;
+
+    /* box covered in the window by the last frame that drew the shape */
+    bool has_box () { return _has_box; }
+    void set_box (double x, double y, double w, double h);
+    /* adds the old and new boxes to d if the shape changed or moved, and to
+     * pick as well if it is drawn in the color picking view */
+    void update_box (double x, double y, double w, double h, DamageRegion &d, DamageRegion &pick);
+    void clear_box (DamageRegion &d, DamageRegion &pick);
+    void set_damaged () { _damaged = true; }
+    bool damaged () { return _damaged; }
     
   private:
     void init_mouse_ui ();
+    void init_matrices ();
+    void update_matrices ();
+    void update_inverse ();
     Process* _matrix, *_inverted_matrix;
+    double _ctm[6], _inverse[6];
+    bool _has_inverse;
     DoubleProperty *_origin_x, *_origin_y;
+    double _box_x, _box_y, _box_w, _box_h;
+    bool _has_box, _damaged;
     static vector<string> _ui;
     bool _has_ui;
   };
@@ -0,0 +1,86 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "damage.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace djnn
+{
+  static inline bool
+  overlap (const DamageRegion::rect_t &a, const DamageRegion::rect_t &b)
+  {
+    return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+  }
+
+  static inline void
+  merge (DamageRegion::rect_t &a, const DamageRegion::rect_t &b)
+  {
+    a.x0 = std::min (a.x0, b.x0);
+    a.y0 = std::min (a.y0, b.y0);
+    a.x1 = std::max (a.x1, b.x1);
+    a.y1 = std::max (a.y1, b.y1);
+  }
+
+  void
+  DamageRegion::add (double x, double y, double w, double h)
+  {
+    if (_all || !(w > 0) || !(h > 0))
+      return;
+    rect_t r = { (int) floor (x), (int) floor (y), (int) ceil (x + w), (int) ceil (y + h) };
+    /* a merge may make the rectangle overlap others: start again */
+    for (size_t i = 0; i < _rects.size ();) {
+      if (overlap (r, _rects[i])) {
+        merge (r, _rects[i]);
+        _rects.erase (_rects.begin () + i);
+        i = 0;
+      } else
+        i++;
+    }
+    _rects.push_back (r);
+    if (_rects.size () > max_rects) {
+      for (auto &o : _rects)
+        merge (r, o);
+      _rects.assign (1, r);
+    }
+  }
+
+  bool
+  DamageRegion::intersects (double x, double y, double w, double h) const
+  {
+    if (_all)
+      return true;
+    for (auto &r : _rects) {
+      if (x < r.x1 && r.x0 < x + w && y < r.y1 && r.y0 < y + h)
+        return true;
+    }
+    return false;
+  }
+
+  double
+  DamageRegion::area (int width, int height) const
+  {
+    if (_all)
+      return (double) width * height;
+    double a = 0;
+    for (auto &r : _rects) {
+      int w = std::min (r.x1, width) - std::max (r.x0, 0);
+      int h = std::min (r.y1, height) - std::max (r.y0, 0);
+      if (w > 0 && h > 0)
+        a += (double) w * h;
+    }
+    return a;
+  }
+}
@@ -0,0 +1,48 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace djnn
+{
+  /* The part of a window to repaint, in window pixels: a few disjoint
+   * rectangles, the overlapping ones being merged. Past max_rects, they are
+   * all merged into their bounding box, where more precision would cost
+   * more in tests than it saves in painting. */
+  class DamageRegion
+  {
+  public:
+    struct rect_t
+    {
+      int x0, y0, x1, y1; // x1 and y1 excluded
+    };
+    DamageRegion () : _all (false) {}
+    void add (double x, double y, double w, double h);
+    void add_all () { _all = true; _rects.clear (); }
+    bool all () const { return _all; }
+    bool empty () const { return !_all && _rects.empty (); }
+    bool intersects (double x, double y, double w, double h) const;
+    const std::vector<rect_t>& rects () const { return _rects; }
+    /* pixels to repaint in a window of the given size */
+    double area (int width, int height) const;
+    void clear () { _all = false; _rects.clear (); }
+
+  private:
+    static const unsigned int max_rects = 16;
+    std::vector<rect_t> _rects;
+    bool _all;
+  };
+}
@@ -1,4 +1,4 @@
-lib_srcs := src/gui/abstract_gobj.cpp src/gui/abstract_gshape.cpp src/gui/gui.cpp src/gui/window.cpp
+lib_srcs := src/gui/abstract_gobj.cpp src/gui/abstract_gshape.cpp src/gui/damage.cpp src/gui/gui.cpp src/gui/image_cache.cpp src/gui/window.cpp
 lib_srcs += $(shell find src/gui/picking -name "*.cpp")
 lib_srcs += $(shell find src/gui/shapes -name "*.cpp")
 lib_srcs += $(shell find src/gui/style -name "*.cpp")
@@ -16,6 +16,10 @@ lib_srcgens += $(build_dir)/src/gui/qt/moc_MyQWindow.cpp
 lib_srcs += $(shell find src/gui/qt -name "*.cpp")
 endif
 
+ifeq ($(graphics),SOFT)
+lib_srcs += $(shell find src/gui/soft -name "*.cpp")
+endif
+
 ifeq ($(graphics),SDL)
 include src/gui/sdl/djnn-lib.mk
 endif
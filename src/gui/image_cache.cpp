@@ -0,0 +1,275 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "image_cache.h"
+#include "shapes/shapes.h"
+#include "../core/syshook/syshook.h"
+#include "../core/execution/graph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace djnn
+{
+  using namespace std;
+
+  ImageCache* ImageCache::_instance;
+  std::once_flag ImageCache::onceFlag;
+
+  ImageCache&
+  ImageCache::instance ()
+  {
+    std::call_once (ImageCache::onceFlag, [] () {
+      _instance = new ImageCache ();
+    });
+
+    return *(_instance);
+  }
+
+  ImageCache::ImageCache () :
+      _budget (64 << 20), _used (0), _busy (false), _thread (nullptr)
+  {
+  }
+
+  void
+  ImageCache::set_codec (decoder_t decode, scaler_t scale)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _decode = decode;
+    _scale = scale;
+  }
+
+  /* the same file under different names is decoded once */
+  const string&
+  ImageCache::resolve (const string &path)
+  {
+    auto it = _resolved.find (path);
+    if (it != _resolved.end ())
+      return it->second;
+#if defined(__WIN32__)
+    char *r = _fullpath (nullptr, path.c_str (), 0);
+#else
+    char *r = realpath (path.c_str (), nullptr);
+#endif
+    string &resolved = _resolved[path];
+    resolved = r != nullptr ? r : path;
+    free (r);
+    return resolved;
+  }
+
+  /* the entry of the file, or of its copy scaled to w x h, queued for the
+   * worker thread if it is new, with i waiting for it while it is pending */
+  ImageCache::entry_it
+  ImageCache::find (const string &path, int w, int h, Image *i)
+  {
+    string key = w > 0 ? path + "@" + to_string (w) + "x" + to_string (h) : path;
+    auto it = _entries.find (key);
+    if (it != _entries.end ()) {
+      entry_it e = it->second;
+      _lru.splice (_lru.begin (), _lru, e);
+      if (e->pending && std::find (e->waiting.begin (), e->waiting.end (), i) == e->waiting.end ())
+        e->waiting.push_back (i);
+      return e;
+    }
+    _lru.push_front (entry_t ());
+    entry_it e = _lru.begin ();
+    e->key = key;
+    e->path = path;
+    e->w = w;
+    e->h = h;
+    e->bytes = 0;
+    e->pending = true;
+    e->fresh = false;
+    e->waiting.push_back (i);
+    _entries[key] = e;
+    _queue.push_back (key);
+    if (_thread == nullptr)
+      _thread = new std::thread (&ImageCache::run, this);
+    else
+      _cond.notify_one ();
+    return e;
+  }
+
+  shared_ptr<ImageData>
+  ImageCache::get (Image *i, int w, int h)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (!_decode)
+      return nullptr;
+    const string &path = resolve (i->path ()->get_value ());
+    entry_it file = find (path, 0, 0, i);
+    file->fresh = false;
+    shared_ptr<ImageData> data = file->data;
+    if (data == nullptr || !_scale || w <= 0 || h <= 0 || (w == data->width () && h == data->height ())
+        || (size_t) w * h * 4 > _budget / 4)
+      return data;
+    entry_it scaled = find (path, w, h, i);
+    if (scaled->pending) {
+      scaled->source = data;
+      return data;
+    }
+    scaled->fresh = false;
+    return scaled->data != nullptr ? scaled->data : data;
+  }
+
+  void
+  ImageCache::forget (Image *i)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    for (auto &e : _lru)
+      if (e.pending)
+        e.waiting.erase (std::remove (e.waiting.begin (), e.waiting.end (), i), e.waiting.end ());
+    _ready.erase (std::remove (_ready.begin (), _ready.end (), i), _ready.end ());
+  }
+
+  void
+  ImageCache::set_budget (size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _budget = bytes;
+    evict ();
+  }
+
+  size_t
+  ImageCache::budget ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    return _budget;
+  }
+
+  size_t
+  ImageCache::used ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    return _used;
+  }
+
+  void
+  ImageCache::clear ()
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    /* the pending entries stay queued, with the Images waiting for them */
+    for (auto e = _lru.begin (); e != _lru.end ();) {
+      if (e->pending) {
+        ++e;
+        continue;
+      }
+      _entries.erase (e->key);
+      e = _lru.erase (e);
+    }
+    _resolved.clear ();
+    _used = 0;
+  }
+
+  void
+  ImageCache::wait_idle ()
+  {
+    std::unique_lock<std::mutex> lock (_mutex);
+    _cond_idle.wait (lock, [this] () { return _queue.empty () && !_busy; });
+  }
+
+  /* the pending and fresh entries are never dropped: their Images are waiting */
+  void
+  ImageCache::evict ()
+  {
+    for (auto e = _lru.end (); _used > _budget && e != _lru.begin ();) {
+      --e;
+      if (e->pending || e->fresh)
+        continue;
+      _used -= e->bytes;
+      _entries.erase (e->key);
+      e = _lru.erase (e);
+    }
+  }
+
+  void
+  ImageCache::run ()
+  {
+    std::unique_lock<std::mutex> lock (_mutex);
+    for (;;) {
+      if (_queue.empty ()) {
+        _busy = false;
+        _cond_idle.notify_all ();
+        _cond.wait (lock);
+        continue;
+      }
+      _busy = true;
+      string key = _queue.front ();
+      _queue.pop_front ();
+      auto it = _entries.find (key);
+      if (it == _entries.end ())
+        continue;
+      string path = it->second->path;
+      int w = it->second->w, h = it->second->h;
+      shared_ptr<ImageData> source = it->second->source;
+      it->second->source.reset ();
+      decoder_t decode = _decode;
+      scaler_t scale = _scale;
+      lock.unlock ();
+      ImageData *data = nullptr;
+      try {
+        if (w == 0)
+          data = decode (path);
+        else if (source != nullptr)
+          data = scale (*source, w, h);
+      } catch (std::exception& e) {
+        std::cerr << "Warning: image " << path << " not loaded: " << e.what () << std::endl;
+      }
+      source.reset ();
+      lock.lock ();
+      it = _entries.find (key);
+      if (it == _entries.end () || !it->second->pending) {
+        delete data;
+        continue;
+      }
+      entry_t &e = *it->second;
+      e.data.reset (data);
+      e.bytes = data != nullptr ? data->bytes () : 0;
+      e.pending = false;
+      e.fresh = true;
+      _used += e.bytes;
+      _ready.insert (_ready.end (), e.waiting.begin (), e.waiting.end ());
+      e.waiting.clear ();
+      evict ();
+      if (!_ready.empty ()) {
+        lock.unlock ();
+        deliver ();
+        lock.lock ();
+      }
+    }
+  }
+
+  /* same order as the Images drawn from the graph: exclusive access, then our mutex */
+  void
+  ImageCache::deliver ()
+  {
+    djnn::get_exclusive_access (DBG_GET); // no break after this call without release !!
+    {
+      GraphUpdate update; // all the Images ready now are redrawn by a single run of the graph
+      for (;;) {
+        Image *i;
+        {
+          std::lock_guard<std::mutex> lock (_mutex);
+          if (_ready.empty ())
+            break;
+          i = _ready.back ();
+          _ready.pop_back ();
+        }
+        i->redraw ();
+      }
+    }
+    djnn::release_exclusive_access (DBG_REL); // no break before this call without release !!
+  }
+}
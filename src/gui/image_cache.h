@@ -0,0 +1,105 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace djnn
+{
+  class Image;
+
+  /* an image as decoded by the backend */
+  class ImageData
+  {
+  public:
+    virtual ~ImageData () {}
+    virtual int width () const = 0;
+    virtual int height () const = 0;
+    virtual size_t bytes () const = 0;
+  };
+
+  /* Images decoded once per file, whatever the number of Image shapes
+   * showing it, with their copies scaled to the sizes they are drawn at.
+   * The files are decoded and scaled by a worker thread: an Image waiting
+   * for its file draws nothing, and is redrawn once the file is ready.
+   * Past the memory budget, the entries drawn the least recently are
+   * dropped, but not before they have been drawn once: a budget below
+   * the images of a frame has them decoded again at every frame. */
+  class ImageCache
+  {
+  public:
+    typedef std::function<ImageData* (const std::string &path)> decoder_t;
+    typedef std::function<ImageData* (const ImageData &src, int w, int h)> scaler_t;
+
+    static ImageCache& instance ();
+    /* set by the backend, without a scaler the images are drawn as decoded */
+    void set_codec (decoder_t decode, scaler_t scale);
+    /* the image of i, its copy scaled to w x h if it is ready, or null while
+     * the file is decoded or if it could not be */
+    std::shared_ptr<ImageData> get (Image *i, int w, int h);
+    /* i is not waiting for anything anymore */
+    void forget (Image *i);
+    void set_budget (size_t bytes);
+    size_t budget ();
+    size_t used ();
+    void clear ();
+    /* until the worker thread has nothing left to do */
+    void wait_idle ();
+
+  private:
+    ImageCache ();
+    struct entry_t
+    {
+      std::string key, path;
+      int w, h; // 0 for the file as decoded
+      std::shared_ptr<ImageData> data;
+      std::shared_ptr<ImageData> source; // of a scaled copy, until it is made
+      size_t bytes;
+      bool pending;
+      bool fresh; // decoded, not drawn yet
+      std::vector<Image*> waiting;
+    };
+    typedef std::list<entry_t>::iterator entry_it;
+    const std::string& resolve (const std::string &path);
+    entry_it find (const std::string &path, int w, int h, Image *i);
+    void evict ();
+    void run ();
+    void deliver ();
+
+    static ImageCache* _instance;
+    static std::once_flag onceFlag;
+    decoder_t _decode;
+    scaler_t _scale;
+    std::mutex _mutex;
+    std::condition_variable _cond, _cond_idle;
+    std::list<entry_t> _lru; // the most recently drawn first
+    std::unordered_map<std::string, entry_it> _entries;
+    std::unordered_map<std::string, std::string> _resolved;
+    std::deque<std::string> _queue; // keys of the entries to decode or scale
+    std::vector<Image*> _ready;
+    size_t _budget, _used;
+    bool _busy;
+    std::thread* _thread;
+  };
+}
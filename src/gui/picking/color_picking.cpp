@@ -55,13 +55,28 @@ namespace djnn
   void
   ColorPickingView::add_gobj (AbstractGShape *gobj)
   {
-    _color_map.insert (pair<unsigned int, AbstractGShape*> (_pick_color, gobj));
+    color_for (gobj);
+  }
+
+  unsigned int
+  ColorPickingView::color_for (AbstractGShape *gobj)
+  {
+    auto it = _shape_color.find (gobj);
+    if (it != _shape_color.end ())
+      return it->second;
+    unsigned int color = _pick_color;
+    _color_map.insert (pair<unsigned int, AbstractGShape*> (color, gobj));
+    _shape_color.insert (pair<AbstractGShape*, unsigned int> (gobj, color));
     next_color();
+    return color;
   }
 
   AbstractGShape*
   ColorPickingView::pick (double x, double y)
   {
+    /* the view is only drawn when it is needed where it is out of date */
+    if (_win->pick_damage ().intersects (x, y, 1, 1))
+      _win->win_impl ()->update_picking ();
     int color = get_pixel (x, y);
     auto it = _color_map.find (color);
     if (it != _color_map.end ()) {
@@ -78,6 +93,7 @@ namespace djnn
     next_color();
     if (!_color_map.empty ())
       _color_map.clear ();
+    _shape_color.clear ();
   }
 
 
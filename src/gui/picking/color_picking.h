@@ -31,11 +31,15 @@ namespace djnn {
     unsigned int pick_color () { return _pick_color; }
     AbstractGShape* pick (double x, double y);
     void add_gobj (AbstractGShape* gobj);
+    /* the color of a shape already drawn since init, or a new one */
+    unsigned int color_for (AbstractGShape* gobj);
+    size_t num_colors () { return _color_map.size (); }
     virtual int get_pixel(int x, int y) = 0;
 
   protected:
     unsigned int _pick_color;
     map<unsigned int, AbstractGShape*> _color_map;
+    map<AbstractGShape*, unsigned int> _shape_color;
 
     double myrandom();
     int seed;
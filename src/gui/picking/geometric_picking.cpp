@@ -0,0 +1,317 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "geometric_picking.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace djnn
+{
+  /* shapes per leaf of the hierarchy */
+  static const int leaf_size = 4;
+
+  GeometricPicking::GeometricPicking (Window *win) :
+      Picking (win), _built (false), _half_stroke (0), _clip (-1)
+  {
+    set_matrix (1, 0, 0, 1, 0, 0);
+  }
+
+  GeometricPicking::~GeometricPicking ()
+  {
+  }
+
+  void
+  GeometricPicking::init ()
+  {
+    _shapes.clear ();
+    _subpaths.clear ();
+    _nodes.clear ();
+    _order.clear ();
+    _built = false;
+    _half_stroke = 0;
+    _clip = -1;
+  }
+
+  void
+  GeometricPicking::set_matrix (double a, double b, double c, double d, double e, double f)
+  {
+    _m[0] = a;
+    _m[1] = b;
+    _m[2] = c;
+    _m[3] = d;
+    _m[4] = e;
+    _m[5] = f;
+  }
+
+  GeometricPicking::shape_t&
+  GeometricPicking::add (AbstractGShape* gobj, int kind)
+  {
+    _shapes.emplace_back ();
+    shape_t &s = _shapes.back ();
+    s.gobj = gobj;
+    s.kind = kind;
+    s.half_stroke = _half_stroke;
+    /* a clip left by a previous frame is ignored */
+    int index = _shapes.size () - 1;
+    s.clip = _clip >= 0 && _clip < index && _shapes[_clip].gobj == nullptr ? _clip : -1;
+    s.even_odd = false;
+    s.first = s.last = 0;
+    double det = _m[0] * _m[3] - _m[1] * _m[2];
+    if (det == 0) {
+      /* flattened to nothing, never hit */
+      std::fill (s.inv, s.inv + 6, 0);
+      s.half_stroke = -1;
+    } else {
+      s.inv[0] = _m[3] / det;
+      s.inv[1] = -_m[1] / det;
+      s.inv[2] = -_m[2] / det;
+      s.inv[3] = _m[0] / det;
+      s.inv[4] = -(s.inv[0] * _m[4] + s.inv[2] * _m[5]);
+      s.inv[5] = -(s.inv[1] * _m[4] + s.inv[3] * _m[5]);
+    }
+    _built = false;
+    return s;
+  }
+
+  /* the box in the window of a box of the shape, outline included */
+  void
+  GeometricPicking::set_box (shape_t &s, double x0, double y0, double x1, double y1)
+  {
+    double hs = std::max (s.half_stroke, 0.);
+    x0 -= hs;
+    y0 -= hs;
+    x1 += hs;
+    y1 += hs;
+    double xs[4] = { x0, x1, x0, x1 }, ys[4] = { y0, y0, y1, y1 };
+    s.box[0] = s.box[1] = HUGE_VAL;
+    s.box[2] = s.box[3] = -HUGE_VAL;
+    for (int i = 0; i < 4; i++) {
+      double x = _m[0] * xs[i] + _m[2] * ys[i] + _m[4];
+      double y = _m[1] * xs[i] + _m[3] * ys[i] + _m[5];
+      s.box[0] = std::min (s.box[0], x);
+      s.box[1] = std::min (s.box[1], y);
+      s.box[2] = std::max (s.box[2], x);
+      s.box[3] = std::max (s.box[3], y);
+    }
+  }
+
+  int
+  GeometricPicking::add_rect (AbstractGShape* gobj, double x, double y, double w, double h, double rx, double ry)
+  {
+    shape_t &s = add (gobj, RECT);
+    s.x = x;
+    s.y = y;
+    s.w = w;
+    s.h = h;
+    /* as when drawn, the corners take at most half of each side */
+    s.rx = std::min (std::max (rx, 0.), w / 2);
+    s.ry = std::min (std::max (ry, 0.), h / 2);
+    set_box (s, x, y, x + w, y + h);
+    return _shapes.size () - 1;
+  }
+
+  int
+  GeometricPicking::add_ellipse (AbstractGShape* gobj, double cx, double cy, double rx, double ry)
+  {
+    shape_t &s = add (gobj, ELLIPSE);
+    s.x = cx;
+    s.y = cy;
+    s.rx = std::fabs (rx);
+    s.ry = std::fabs (ry);
+    set_box (s, cx - s.rx, cy - s.ry, cx + s.rx, cy + s.ry);
+    return _shapes.size () - 1;
+  }
+
+  int
+  GeometricPicking::add_path (AbstractGShape* gobj, const vector<vector<double> > &subpaths, const vector<bool> &closed,
+                              bool even_odd)
+  {
+    shape_t &s = add (gobj, PATH);
+    s.even_odd = even_odd;
+    s.first = _subpaths.size ();
+    double x0 = HUGE_VAL, y0 = HUGE_VAL, x1 = -HUGE_VAL, y1 = -HUGE_VAL;
+    for (size_t i = 0; i < subpaths.size (); i++) {
+      const vector<double> &pts = subpaths[i];
+      if (pts.size () < 2)
+        continue;
+      for (size_t j = 0; j + 1 < pts.size (); j += 2) {
+        x0 = std::min (x0, pts[j]);
+        y0 = std::min (y0, pts[j + 1]);
+        x1 = std::max (x1, pts[j]);
+        y1 = std::max (y1, pts[j + 1]);
+      }
+      _subpaths.push_back ( { pts, i < closed.size () && closed[i] });
+    }
+    s.last = _subpaths.size ();
+    if (s.first == s.last) {
+      s.half_stroke = -1;
+      std::fill (s.box, s.box + 4, 0);
+    } else
+      set_box (s, x0, y0, x1, y1);
+    return _shapes.size () - 1;
+  }
+
+  static double
+  segment_distance2 (double px, double py, double x0, double y0, double x1, double y1)
+  {
+    double dx = x1 - x0, dy = y1 - y0, l2 = dx * dx + dy * dy;
+    double t = l2 == 0 ? 0 : std::max (0., std::min (1., ((px - x0) * dx + (py - y0) * dy) / l2));
+    double ex = x0 + t * dx - px, ey = y0 + t * dy - py;
+    return ex * ex + ey * ey;
+  }
+
+  /* the fill closes every subpath, the outline only the closed ones */
+  bool
+  GeometricPicking::path_contains (const shape_t &s, double x, double y) const
+  {
+    int winding = 0;
+    double hs2 = s.half_stroke * s.half_stroke;
+    for (size_t i = s.first; i < s.last; i++) {
+      const vector<double> &p = _subpaths[i].pts;
+      size_t n = p.size () / 2;
+      for (size_t j = 0; j < n; j++) {
+        size_t k = (j + 1) % n;
+        double x0 = p[2 * j], y0 = p[2 * j + 1], x1 = p[2 * k], y1 = p[2 * k + 1];
+        if (s.half_stroke > 0 && (k != 0 || _subpaths[i].closed)
+            && segment_distance2 (x, y, x0, y0, x1, y1) <= hs2)
+          return true;
+        if ((y0 <= y) != (y1 <= y)) {
+          double cx = x0 + (y - y0) * (x1 - x0) / (y1 - y0);
+          if (cx > x)
+            winding += y1 > y0 ? 1 : -1;
+        }
+      }
+    }
+    return s.even_odd ? (winding & 1) : winding != 0;
+  }
+
+  bool
+  GeometricPicking::contains (const shape_t &s, double x, double y) const
+  {
+    if (s.half_stroke < 0)
+      return false;
+    if (s.clip >= 0 && !contains (_shapes[s.clip], x, y))
+      return false;
+    double lx = s.inv[0] * x + s.inv[2] * y + s.inv[4];
+    double ly = s.inv[1] * x + s.inv[3] * y + s.inv[5];
+    double hs = s.half_stroke;
+    switch (s.kind)
+      {
+      case RECT:
+        {
+          if (lx < s.x - hs || lx > s.x + s.w + hs || ly < s.y - hs || ly > s.y + s.h + hs)
+            return false;
+          if (s.rx <= 0 || s.ry <= 0)
+            return true;
+          /* distance to the center of the nearest corner */
+          double cx = std::max (s.x + s.rx, std::min (lx, s.x + s.w - s.rx));
+          double cy = std::max (s.y + s.ry, std::min (ly, s.y + s.h - s.ry));
+          double dx = (lx - cx) / (s.rx + hs), dy = (ly - cy) / (s.ry + hs);
+          return dx * dx + dy * dy <= 1;
+        }
+      case ELLIPSE:
+        {
+          if (s.rx + hs <= 0 || s.ry + hs <= 0)
+            return false;
+          double dx = (lx - s.x) / (s.rx + hs), dy = (ly - s.y) / (s.ry + hs);
+          return dx * dx + dy * dy <= 1;
+        }
+      default:
+        return path_contains (s, lx, ly);
+      }
+  }
+
+  /* median split along the longest side of the box of the centers */
+  int
+  GeometricPicking::build (int first, int count)
+  {
+    int index = _nodes.size ();
+    _nodes.emplace_back ();
+    node_t n;
+    n.box[0] = n.box[1] = HUGE_VAL;
+    n.box[2] = n.box[3] = -HUGE_VAL;
+    n.max_order = -1;
+    double c[4] = { HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+    for (int i = first; i < first + count; i++) {
+      const shape_t &s = _shapes[_order[i]];
+      for (int k = 0; k < 2; k++) {
+        n.box[k] = std::min (n.box[k], s.box[k]);
+        n.box[k + 2] = std::max (n.box[k + 2], s.box[k + 2]);
+        double m = (s.box[k] + s.box[k + 2]) / 2;
+        c[k] = std::min (c[k], m);
+        c[k + 2] = std::max (c[k + 2], m);
+      }
+      n.max_order = std::max (n.max_order, _order[i]);
+    }
+    n.first = first;
+    n.count = count;
+    n.left = n.right = -1;
+    if (count > leaf_size) {
+      int axis = c[2] - c[0] >= c[3] - c[1] ? 0 : 1;
+      auto begin = _order.begin () + first;
+      std::nth_element (begin, begin + count / 2, begin + count, [this, axis] (int a, int b) {
+        return _shapes[a].box[axis] + _shapes[a].box[axis + 2] < _shapes[b].box[axis] + _shapes[b].box[axis + 2];
+      });
+      n.left = build (first, count / 2);
+      n.right = build (first + count / 2, count - count / 2);
+    }
+    _nodes[index] = n;
+    return index;
+  }
+
+  /* the last shape in paint order is on top: the nodes that hold no shape
+   * painted after the best one found so far are skipped */
+  void
+  GeometricPicking::search (int node, double x, double y, int &best) const
+  {
+    const node_t &n = _nodes[node];
+    if (n.max_order <= best || x < n.box[0] || x > n.box[2] || y < n.box[1] || y > n.box[3])
+      return;
+    if (n.left < 0) {
+      for (int i = n.first; i < n.first + n.count; i++) {
+        int k = _order[i];
+        const shape_t &s = _shapes[k];
+        if (k > best && x >= s.box[0] && x <= s.box[2] && y >= s.box[1] && y <= s.box[3] && contains (s, x, y))
+          best = k;
+      }
+      return;
+    }
+    int a = n.left, b = n.right;
+    if (_nodes[a].max_order < _nodes[b].max_order)
+      std::swap (a, b);
+    search (a, x, y, best);
+    search (b, x, y, best);
+  }
+
+  AbstractGShape*
+  GeometricPicking::pick (double x, double y)
+  {
+    if (!_built) {
+      _nodes.clear ();
+      _order.clear ();
+      for (size_t i = 0; i < _shapes.size (); i++)
+        if (_shapes[i].gobj != nullptr)
+          _order.push_back (i);
+      if (!_order.empty ())
+        build (0, _order.size ());
+      _built = true;
+    }
+    if (_nodes.empty ())
+      return nullptr;
+    int best = -1;
+    search (0, x, y, best);
+    return best < 0 ? nullptr : _shapes[best].gobj;
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "picking.h"
+
+#include <vector>
+
+namespace djnn
+{
+  /* Picking from the geometry of the shapes, without drawing them: the
+   * backends record the pickable shapes in paint order, and the pointer is
+   * tested against those whose box in the window contains it, found in a
+   * bounding volume hierarchy built on the first pick after a frame.
+   *
+   * The geometry is given in the coordinates of the shape, with the matrix
+   * mapping them into the window: x' = a x + c y + e, y' = b x + d y + f.
+   * As with the picking colors, a shape is hit in its fill, whatever its
+   * style, and within half the stroke width of its outline. */
+  class GeometricPicking : public Picking
+  {
+  public:
+    GeometricPicking (Window *win);
+    virtual
+    ~GeometricPicking ();
+    /* forgets the shapes, before a frame that goes through all of them */
+    void init () override;
+    AbstractGShape* pick (double x, double y) override;
+    void add_gobj (AbstractGShape* gobj) override {}
+    int get_pixel (int x, int y) override { return -1; }
+
+    /* for the shapes added next */
+    void set_matrix (double a, double b, double c, double d, double e, double f);
+    void set_half_stroke (double w) { _half_stroke = w; }
+    /* a shape recorded with a null gobj, as returned by add_*, -1 for none */
+    void set_clip (int clip) { _clip = clip; }
+
+    /* a null gobj records a clip, to be passed to set_clip */
+    int add_rect (AbstractGShape* gobj, double x, double y, double w, double h, double rx = 0, double ry = 0);
+    int add_ellipse (AbstractGShape* gobj, double cx, double cy, double rx, double ry);
+    /* subpaths of interleaved x and y coordinates */
+    int add_path (AbstractGShape* gobj, const vector<vector<double> > &subpaths, const vector<bool> &closed,
+                  bool even_odd);
+
+    size_t size () { return _shapes.size (); }
+
+  private:
+    enum { RECT, ELLIPSE, PATH };
+    struct shape_t
+    {
+      AbstractGShape *gobj;
+      int kind;
+      double inv[6]; // from the window to the shape
+      double x, y, w, h, rx, ry; // rectangle, or center and radii of an ellipse
+      size_t first, last; // subpaths of a path in _subpaths
+      bool even_odd;
+      double half_stroke;
+      int clip;
+      double box[4]; // x0, y0, x1, y1 in the window
+    };
+    struct subpath_t
+    {
+      vector<double> pts;
+      bool closed;
+    };
+    struct node_t
+    {
+      double box[4];
+      int max_order; // last in paint order below this node
+      int left, right; // children, or -1 and the first shape for a leaf
+      int first, count;
+    };
+    shape_t& add (AbstractGShape* gobj, int kind);
+    void set_box (shape_t &s, double x0, double y0, double x1, double y1);
+    bool contains (const shape_t &s, double x, double y) const;
+    bool path_contains (const shape_t &s, double x, double y) const;
+    int build (int first, int count);
+    void search (int node, double x, double y, int &best) const;
+
+    vector<shape_t> _shapes;
+    vector<subpath_t> _subpaths;
+    vector<node_t> _nodes;
+    vector<int> _order; // shape indices, grouped by leaf
+    bool _built;
+    double _m[6];
+    double _half_stroke;
+    int _clip;
+  };
+}
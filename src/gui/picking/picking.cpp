@@ -16,9 +16,15 @@
  */
 #include "color_picking.h"
 #include "../transformation/transformations.h"
+#include "../../core/tree/path_ref.h"
 
 namespace djnn
 {
+  /* children of the shapes reached on every event */
+  static PathRef press_path ("press"), press_x_path ("press/x"), press_y_path ("press/y");
+  static PathRef move_path ("move"), move_x_path ("move/x"), move_y_path ("move/y");
+  static PathRef move_local_x_path ("move/local_x"), move_local_y_path ("move/local_y");
+  static PathRef release_path ("release"), enter_path ("enter"), leave_path ("leave"), touches_path ("touches");
 
   Picking::Picking (Window *win) :
       _win (win), _cur_obj (nullptr)
@@ -40,15 +46,16 @@ namespace djnn
   void
   Picking::set_local_coords (AbstractGShape* s, Touch *t, double x, double y)
   {
-    Homography *h = dynamic_cast<Homography*> (s->inverted_matrix ());
-    double loc_x = h->_m11->get_value () * x + h->_m12->get_value () * y + h->_m13->get_value () + h->_m14->get_value () - s->origin_x ()->get_value ();
-    double loc_y = h->_m21->get_value () * x + h->_m22->get_value () * y + h->_m23->get_value () + h->_m24->get_value () - s->origin_y ()->get_value ();
+    double loc_x, loc_y;
+    s->window_to_local (x, y, loc_x, loc_y);
+    loc_x -= s->origin_x ()->get_value ();
+    loc_y -= s->origin_y ()->get_value ();
     if (t != nullptr) {
       t->set_local_x (loc_x);
       t->set_local_y (loc_y);
     } else {
-      ((DoubleProperty*) s->find_component ("move/local_x"))->set_value (loc_x, true);
-      ((DoubleProperty*) s->find_component ("move/local_y"))->set_value (loc_y, true);
+      ((DoubleProperty*) move_local_x_path.find (s))->set_value (loc_x, true);
+      ((DoubleProperty*) move_local_y_path.find (s))->set_value (loc_y, true);
     }
   }
 
@@ -63,12 +70,12 @@ namespace djnn
     _win->press ()->notify_activation ();
     AbstractGShape *s = this->pick (x, y);
     if (s != nullptr) {
-      ((DoubleProperty*) s->find_component ("press/x"))->set_value (x, true);
-      ((DoubleProperty*) s->find_component ("press/y"))->set_value (y, true);
-      ((DoubleProperty*) s->find_component ("move/x"))->set_value (x, true);
-      ((DoubleProperty*) s->find_component ("move/y"))->set_value (y, true);
+      ((DoubleProperty*) press_x_path.find (s))->set_value (x, true);
+      ((DoubleProperty*) press_y_path.find (s))->set_value (y, true);
+      ((DoubleProperty*) move_x_path.find (s))->set_value (x, true);
+      ((DoubleProperty*) move_y_path.find (s))->set_value (y, true);
       set_local_coords (s, nullptr, x, y);
-      s->find_component ("press")->notify_activation ();
+      press_path.find (s)->notify_activation ();
       exec_ = true;
     }
     if (_win->press ()->has_coupling () || _win->press_x ()->has_coupling () || _win->press_y ()->has_coupling ()) {
@@ -86,7 +93,7 @@ namespace djnn
       t = it->second;
       _win->touches ()->remove_child (t);
       if (t->shape () != nullptr) {
-        t->shape ()->find_component ("touches")->remove_child (t);
+        touches_path.find (t->shape ())->remove_child (t);
       }
       _active_touches.erase (it);
       delete t;
@@ -99,7 +106,7 @@ namespace djnn
     if (s != nullptr) {
       t->set_shape (s);
       set_local_coords (s, t, x, y);
-      s->find_component ("touches")->add_child (t, to_string (id));
+      touches_path.find (s)->add_child (t, to_string (id));
     }
     return true;
   }
@@ -118,20 +125,20 @@ namespace djnn
       exec_ = true;
     }
     if (s) {
-      if (x != old_x) ((DoubleProperty*) s->find_component ("move/x"))->set_value (x, true);
-      if (y != old_y) ((DoubleProperty*) s->find_component ("move/y"))->set_value (y, true);
+      if (x != old_x) ((DoubleProperty*) move_x_path.find (s))->set_value (x, true);
+      if (y != old_y) ((DoubleProperty*) move_y_path.find (s))->set_value (y, true);
       set_local_coords (s, nullptr, x, y);
       if (s != _cur_obj) {
         if (_cur_obj != 0)
-          _cur_obj->find_component ("leave")->notify_activation ();
-        s->find_component ("enter")->notify_activation ();
+          leave_path.find (_cur_obj)->notify_activation ();
+        enter_path.find (s)->notify_activation ();
         _cur_obj = s;
       }
-      s->find_component ("move")->notify_activation ();
+      move_path.find (s)->notify_activation ();
       exec_ = true;
     } else {
       if (_cur_obj != nullptr) {
-        _cur_obj->find_component ("leave")->notify_activation ();
+        leave_path.find (_cur_obj)->notify_activation ();
         _cur_obj = nullptr;
         exec_ = true;
       }
@@ -145,8 +152,8 @@ namespace djnn
     bool exec_ = false;
     AbstractGShape *s = this->pick (x, y);
     if (s) {
-      double cur_move_x = ((DoubleProperty*) s->find_component ("move/x"))->get_value ();
-      double cur_move_y = ((DoubleProperty*) s->find_component ("move/y"))->get_value ();
+      double cur_move_x = ((DoubleProperty*) move_x_path.find (s))->get_value ();
+      double cur_move_y = ((DoubleProperty*) move_y_path.find (s))->get_value ();
       if (s == _cur_obj) {
         if (cur_move_x == x && cur_move_y ==y)
           return exec_;
@@ -155,14 +162,14 @@ namespace djnn
         }
       } else {
         if (_cur_obj != 0)
-          _cur_obj->find_component ("leave")->notify_activation ();
-        s->find_component ("enter")->notify_activation ();
+          leave_path.find (_cur_obj)->notify_activation ();
+        enter_path.find (s)->notify_activation ();
         _cur_obj = s;
         exec_ = true;
       }
     } else {
       if (_cur_obj != nullptr) {
-        _cur_obj->find_component ("leave")->notify_activation ();
+        leave_path.find (_cur_obj)->notify_activation ();
         _cur_obj = nullptr;
         exec_ = true;
       }
@@ -182,15 +189,15 @@ namespace djnn
       AbstractGShape *s = this->pick (x, y);
       AbstractGShape *t_shape = t->shape ();
       if (s == nullptr && t_shape != nullptr) {
-        t_shape->find_component ("touches")->remove_child (t);
+        touches_path.find (t_shape)->remove_child (t);
         t->set_shape (nullptr);
       } else if (s != nullptr) {
         if (t_shape == nullptr) {
-          s->find_component ("touches")->add_child (t, to_string (id));
+          touches_path.find (s)->add_child (t, to_string (id));
           t->set_shape (s);
         } else if (s != t_shape) {
-          t_shape->find_component ("touches")->remove_child (t);
-          s->find_component ("touches")->add_child (t, to_string (id));
+          touches_path.find (t_shape)->remove_child (t);
+          touches_path.find (s)->add_child (t, to_string (id));
           t->set_shape (s);
         }
         set_local_coords (s, t, x, y);
@@ -209,15 +216,15 @@ namespace djnn
     if (s) {
       if (s != _cur_obj) {
         if (_cur_obj != nullptr)
-          _cur_obj->find_component ("leave")->notify_activation ();
-        s->find_component ("enter")->notify_activation ();
+          leave_path.find (_cur_obj)->notify_activation ();
+        enter_path.find (s)->notify_activation ();
         _cur_obj = s;
       }
-      s->find_component ("release")->notify_activation ();
+      release_path.find (s)->notify_activation ();
       exec_ = true;
     } else {
       if (_cur_obj != nullptr) {
-        _cur_obj->find_component ("leave")->notify_activation ();
+        leave_path.find (_cur_obj)->notify_activation ();
         _cur_obj = 0;
         exec_ = true;
       }
@@ -240,7 +247,7 @@ namespace djnn
       t->set_y (y);
       AbstractGShape *t_shape = t->shape ();
       if (t_shape != nullptr) {
-        t_shape->find_component ("touches")->remove_child (t);
+        touches_path.find (t_shape)->remove_child (t);
         set_local_coords (t_shape, t, x, y);
       }
       _win->touches ()->remove_child (t);
@@ -23,6 +23,7 @@
 #include "../../core/syshook/external_source.h"
 #include "../window.h"
 #include "../qt/qt_window.h"
+#include "../picking/geometric_picking.h"
 
 namespace djnn {
 
@@ -33,8 +34,11 @@ namespace djnn {
     // /usr/local/Cellar/qt5/5.10.1/bin/moc src/gui/qt/my_qwindow.h > src/gui/qt/moc_MyQWindow.cpp 
 
   public:
-    MyQWidget(Window *w, QtWindow * qtw) : _window (w), _qtwindow (qtw), _updating (false) {  setAttribute(Qt::WA_AcceptTouchEvents, true); _picking_view = new QtPickingView (w); }
-    virtual ~MyQWidget () { delete _picking_view; }
+    MyQWidget(Window *w, QtWindow * qtw) : _window (w), _qtwindow (qtw), _updating (false) {  setAttribute(Qt::WA_AcceptTouchEvents, true); _picking_view = new QtPickingView (w); _geometric_picking = new GeometricPicking (w); }
+    virtual ~MyQWidget () { delete _picking_view; delete _geometric_picking; }
+    QtPickingView* picking_view () { return _picking_view; }
+    /* the picking view of the mode of the window */
+    Picking* picking () { return _qtwindow->picking_mode () == GEOMETRIC_PICKING ? (Picking*) _geometric_picking : _picking_view; }
   protected:
 
     virtual bool event (QEvent *event) override;
@@ -52,6 +56,7 @@ namespace djnn {
     Window * _window;
     QtWindow * _qtwindow;
     QtPickingView *_picking_view;
+    GeometricPicking *_geometric_picking;
     int mouse_pos_x, mouse_pos_y;
     bool _updating;
   };
@@ -17,12 +17,14 @@
 #include "qt_context.h"
 #include "qt_backend.h"
 #include "qt_window.h"
+#include "qt_text_layout.h"
 
 #include <QtWidgets/QWidget>
 #include <QtGui/QPainter>
 #include <QtCore/QtMath>
 #include <QtCore/QFileInfo>
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 
 namespace djnn
@@ -41,9 +43,18 @@ namespace djnn
   }
 
   QtBackend::QtBackend () :
-      _painter (nullptr), _picking_view (nullptr)
+      _painter (nullptr), _picking_view (nullptr), _geometric_picking (nullptr)
   {
     _context_manager = new QtContextManager ();
+    ImageCache::instance ().set_codec ([] (const string &path) -> ImageData* {
+      QImage img (QString::fromStdString (path));
+      if (img.isNull ())
+        return nullptr;
+      return new QtImage (img.convertToFormat (QImage::Format_ARGB32_Premultiplied));
+    }, [] (const ImageData &src, int w, int h) -> ImageData* {
+      const QImage &img = static_cast<const QtImage&> (src).image;
+      return new QtImage (img.scaled (w, h, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    });
   }
 
   QtBackend::~QtBackend ()
@@ -51,11 +62,17 @@ namespace djnn
     if (_context_manager) { delete _context_manager; _context_manager = nullptr;}
   }
 
+  /* the rest of the painter state is loaded for each shape: it is saved
+   * only before the first clip of a component, to be restored on leaving it,
+   * or at the end of the frame outside of any component */
   void
   QtBackend::save_context ()
   {
-    if (_painter != nullptr)
-      _painter->save ();
+    QtContext *cur_context = _context_manager->get_current ();
+    if (_painter == nullptr || cur_context->saved)
+      return;
+    _painter->save ();
+    cur_context->saved = true;
   }
 
   void
@@ -67,13 +84,57 @@ namespace djnn
   void
   QtBackend::set_painter (QPainter* p)
   {
+    /* each pass starts and ends here: the clip or the transform left by
+     * the shapes drawn outside of any component don't outlive it */
+    if (_painter != nullptr && _context_manager->base ()->saved)
+      _painter->restore ();
+    _context_manager->reset_base ();
     _painter = p;
   }
 
   void
-  QtBackend::set_picking_view (QtPickingView* p)
+  QtBackend::set_picking_view (Picking* p)
   {
-    _picking_view = p;
+    _picking_view = dynamic_cast<QtPickingView*> (p);
+    _geometric_picking = dynamic_cast<GeometricPicking*> (p);
+  }
+
+  GeometricPicking*
+  QtBackend::geometric_picking (AbstractGShape *s)
+  {
+    /* a partial repaint keeps what the bounds pass has recorded */
+    if (_geometric_picking == nullptr || _damage_pass == PARTIAL_REPAINT || (s != nullptr && !is_pickable (s)))
+      return nullptr;
+    QtContext *cur_context = _context_manager->get_current ();
+    QTransform t = cur_context->matrix.toTransform ();
+    _geometric_picking->set_matrix (t.m11 (), t.m12 (), t.m21 (), t.m22 (), t.dx (), t.dy ());
+    double hs = 0;
+    if (s != nullptr) {
+      /* a cosmetic pen is one pixel wide whatever the scale */
+      double scale = sqrt (fabs (t.determinant ()));
+      hs = cur_context->pen.widthF () > 0 ? cur_context->pen.widthF () / 2 : (scale > 0 ? 0.5 / scale : 0);
+    }
+    _geometric_picking->set_half_stroke (hs);
+    /* a clip replaces the previous one */
+    _geometric_picking->set_clip (s == nullptr ? -1 : cur_context->pick_clip);
+    return _geometric_picking;
+  }
+
+  int
+  QtBackend::add_picking_path (AbstractGShape *s, const QPainterPath &path)
+  {
+    vector<vector<double> > subpaths;
+    vector<bool> closed;
+    for (const QPolygonF &poly : path.toSubpathPolygons ()) {
+      vector<double> pts;
+      for (const QPointF &p : poly) {
+        pts.push_back (p.x ());
+        pts.push_back (p.y ());
+      }
+      subpaths.push_back (pts);
+      closed.push_back (poly.isClosed ());
+    }
+    return _geometric_picking->add_path (s, subpaths, closed, path.fillRule () == Qt::OddEvenFill);
   }
 
   /* Qt context management is imported from djnn v1 */
@@ -83,50 +144,11 @@ namespace djnn
     QtContext *cur_context = _context_manager->get_current ();
     QMatrix4x4 matrix = cur_context->matrix;
     QTransform transform = matrix.toTransform ();
-    if (s->matrix () != nullptr) {
-      Homography *h = dynamic_cast<Homography*> (s->matrix ());
-      Homography *hi = dynamic_cast<Homography*> (s->inverted_matrix ());
-      QMatrix4x4 loc_matrix = QMatrix4x4 (matrix);
-      h->_m11->set_value (loc_matrix (0, 0), false);
-      h->_m12->set_value (loc_matrix (0, 1), false);
-      h->_m13->set_value (loc_matrix (0, 2), false);
-      h->_m14->set_value (loc_matrix (0, 3), false);
-
-      h->_m21->set_value (loc_matrix (1, 0), false);
-      h->_m22->set_value (loc_matrix (1, 1), false);
-      h->_m23->set_value (loc_matrix (1, 2), false);
-      h->_m24->set_value (loc_matrix (1, 3), false);
-
-      h->_m31->set_value (loc_matrix (2, 0), false);
-      h->_m32->set_value (loc_matrix (2, 1), false);
-      h->_m33->set_value (loc_matrix (2, 2), false);
-      h->_m34->set_value (loc_matrix (2, 3), false);
-
-      h->_m41->set_value (loc_matrix (3, 0), false);
-      h->_m42->set_value (loc_matrix (3, 1), false);
-      h->_m43->set_value (loc_matrix (3, 2), false);
-      h->_m44->set_value (loc_matrix (3, 3), false);
-      loc_matrix = loc_matrix.inverted ();
-      hi->_m11->set_value (loc_matrix (0, 0), false);
-      hi->_m12->set_value (loc_matrix (0, 1), false);
-      hi->_m13->set_value (loc_matrix (0, 2), false);
-      hi->_m14->set_value (loc_matrix (0, 3), false);
-
-      hi->_m21->set_value (loc_matrix (1, 0), false);
-      hi->_m22->set_value (loc_matrix (1, 1), false);
-      hi->_m23->set_value (loc_matrix (1, 2), false);
-      hi->_m24->set_value (loc_matrix (1, 3), false);
-
-      hi->_m31->set_value (loc_matrix (2, 0), false);
-      hi->_m32->set_value (loc_matrix (2, 1), false);
-      hi->_m33->set_value (loc_matrix (2, 2), false);
-      hi->_m34->set_value (loc_matrix (2, 3), false);
-
-      hi->_m41->set_value (loc_matrix (3, 0), false);
-      hi->_m42->set_value (loc_matrix (3, 1), false);
-      hi->_m43->set_value (loc_matrix (3, 2), false);
-      hi->_m44->set_value (loc_matrix (3, 3), false);
-    }
+    /* the local coordinates of the pointer are computed from this matrix */
+    s->set_ctm (transform.m11 (), transform.m12 (), transform.m21 (), transform.m22 (), transform.dx (), transform.dy ());
+
+    if (_painter == nullptr)
+      return;
 
     /* setup the painting environment of the drawing view */
     QPen tmpPen (cur_context->pen);
@@ -180,14 +202,28 @@ namespace djnn
   {
     QtContext *cur_context = _context_manager->get_current ();
     QPen pickPen;
-    QBrush pickBrush (_picking_view->pick_color ());
+    unsigned int color = _picking_view->color_for (s);
+    QBrush pickBrush (color);
     pickPen.setStyle (Qt::SolidLine);
-    pickPen.setColor (_picking_view->pick_color ());
+    pickPen.setColor (color);
     pickPen.setWidth (cur_context->pen.width());
     _picking_view->painter ()->setPen (pickPen);
     _picking_view->painter ()->setBrush (pickBrush);
     _picking_view->painter ()->setTransform (cur_context->matrix.toTransform ());
-    _picking_view->add_gobj (s);
+  }
+
+  /* the box covers the outline drawn for picking and the anti-aliasing */
+  bool
+  QtBackend::must_paint (AbstractGShape *s, const QRectF &r)
+  {
+    QtContext *cur_context = _context_manager->get_current ();
+    QTransform transform = cur_context->matrix.toTransform ();
+    QRectF box = transform.mapRect (r);
+    double scale = sqrt (fabs (transform.determinant ()));
+    double w = std::max (cur_context->pen.widthF () * scale, 1.);
+    double miter = cur_context->pen.joinStyle () == Qt::MiterJoin ? std::max (cur_context->pen.miterLimit (), 1.5) : 1.5;
+    double pad = w / 2 * miter + 1;
+    return AbstractBackend::must_paint (s, box.x () - pad, box.y () - pad, box.width () + 2 * pad, box.height () + 2 * pad);
   }
 
   WinImpl*
@@ -199,7 +235,7 @@ namespace djnn
   bool
   QtBackend::is_in_picking_view (AbstractGShape *s)
   {
-    return is_pickable (s);
+    return _picking_view != nullptr && is_pickable (s);
     /*return s->press ()->has_coupling () || s->x ()->has_coupling () || s->y ()->has_coupling ()
         || s->move ()->has_coupling () || s->release ()->has_coupling () || s->enter ()->has_coupling ()
         || s->leave ()->has_coupling ();*/
@@ -226,11 +262,8 @@ namespace djnn
     if (fw) {
       qfont.setWeight (fw->weight ()->get_value ());
     }
-    QString str (text->text ()->get_value().c_str ());
-    QFontMetrics fm (qfont);
-    int width = fm.width (str);
-    int height = fm.height ();
-    text->set_width (width);
-    text->set_height (height);
+    shared_ptr<QtTextLayout> layout = QtTextLayouts::instance ().get (qfont, text->text ()->get_value (), djnUtf8);
+    text->set_width (layout->advance);
+    text->set_height (layout->height);
   }
 } /* namespace djnn */
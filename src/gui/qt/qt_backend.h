@@ -17,7 +17,10 @@
 #include "qt_context.h"
 #include "qt_picking_view.h"
 #include "../abstract_backend.h"
+#include "../picking/geometric_picking.h"
+#include "../image_cache.h"
 #include "../../core/execution/component_observer.h"
+#include <QtGui/QImage>
 #include <QtGui/QPainterPath>
 
 class QWidget;
@@ -28,6 +31,20 @@ namespace djnn
   using namespace std;
 
   class QtContextManager;
+  struct QtGeometry;
+
+  /* a QImage shared through the image cache: unlike a QPixmap, it can be
+   * built away from the GUI thread */
+  class QtImage : public ImageData
+  {
+  public:
+    QtImage (const QImage &i) : image (i) {}
+    int width () const override { return image.width (); }
+    int height () const override { return image.height (); }
+    size_t bytes () const override { return (size_t) image.bytesPerLine () * image.height (); }
+    QImage image;
+  };
+
   class QtBackend : public AbstractBackend
   {
   public:
@@ -41,7 +58,7 @@ namespace djnn
     void
     set_painter (QPainter* p);
     void
-    set_picking_view (QtPickingView *p);
+    set_picking_view (Picking *p);
     QPainter *painter () { return _painter; }
     WinImpl*
     create_window (Window *win, const std::string& title, double x, double y, double w, double h) override;
@@ -171,12 +188,26 @@ namespace djnn
     load_drawing_context (AbstractGShape *s, double tx, double ty, double width, double height);
     void
     load_pick_context (AbstractGShape *s);
+    /* with the box of the shape in its local coordinates */
+    bool
+    must_paint (AbstractGShape *s, const QRectF &r);
+    /* a bounds pass and a picking pass go through the tree without any painter */
+    bool
+    has_target () { return _painter != nullptr || _damage_pass == BOUNDS_PASS || _damage_pass == PICKING_PASS; }
     void
     prepare_gradient (AbstractGradient *g);
     bool
     is_in_picking_view (AbstractGShape *s);
+    /* where to record s, null if it is not recorded in this pass */
+    GeometricPicking*
+    geometric_picking (AbstractGShape *s);
+    int
+    add_picking_path (AbstractGShape *s, const QPainterPath &path);
+    QtGeometry*
+    path_geometry (Path *p);
     QPainter *_painter;
     QtPickingView *_picking_view;
+    GeometricPicking *_geometric_picking;
     QtContextManager *_context_manager;
     QPolygonF cur_poly;
     QPainterPath cur_path;
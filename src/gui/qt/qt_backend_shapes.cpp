@@ -17,11 +17,11 @@
 #include "qt_context.h"
 #include "qt_backend.h"
 #include "qt_window.h"
+#include "qt_text_layout.h"
 
 #include <QtWidgets/QWidget>
 #include <QtGui/QPainter>
 #include <QtCore/QtMath>
-#include <QtCore/QFileInfo>
 #include <iostream>
 #include <cmath>
 
@@ -30,10 +30,15 @@ namespace djnn
   void
   QtBackend::draw_rect (Rectangle *s, double x, double y, double w, double h, double rx, double ry)
   {
-    if (_painter == nullptr)
+    if (!has_target ())
       return;
     load_drawing_context (s, x, y, w, h);
-    _painter->drawRoundedRect (x, y, w, h, rx, ry);
+    if (geometric_picking (s))
+      _geometric_picking->add_rect (s, x, y, w, h, rx, ry);
+    if (!must_paint (s, QRectF (x, y, w, h)))
+      return;
+    if (_painter != nullptr)
+      _painter->drawRoundedRect (x, y, w, h, rx, ry);
 
     if (is_in_picking_view (s)) {
       load_pick_context (s);
@@ -44,11 +49,16 @@ namespace djnn
   void
   QtBackend::draw_circle (Circle *s, double cx, double cy, double r)
   {
-    if (_painter == nullptr)
+    if (!has_target ())
       return;
     QRectF rect (cx - r, cy - r, 2 * r, 2 * r);
     load_drawing_context (s, rect.x (), rect.y (), rect.width (), rect.height ());
-    _painter->drawEllipse (rect);
+    if (geometric_picking (s))
+      _geometric_picking->add_ellipse (s, cx, cy, r, r);
+    if (!must_paint (s, rect))
+      return;
+    if (_painter != nullptr)
+      _painter->drawEllipse (rect);
 
     if (is_in_picking_view (s)) {
       load_pick_context (s);
@@ -59,11 +69,16 @@ namespace djnn
   void
   QtBackend::draw_ellipse (Ellipse *s, double cx, double cy, double rx, double ry)
   {
-    if (_painter == nullptr)
+    if (!has_target ())
       return;
     QRect rect (cx - rx, cy - ry, 2 * rx, 2 * ry);
     load_drawing_context (s, rect.x (), rect.y (), rect.width (), rect.height ());
-    _painter->drawEllipse (rect);
+    if (geometric_picking (s))
+      _geometric_picking->add_ellipse (s, cx, cy, rx, ry);
+    if (!must_paint (s, rect))
+      return;
+    if (_painter != nullptr)
+      _painter->drawEllipse (rect);
 
     if (is_in_picking_view (s)) {
       load_pick_context (s);
@@ -74,11 +89,19 @@ namespace djnn
   void
   QtBackend::draw_line (Line *s, double x1, double y1, double x2, double y2)
   {
-    if (_painter == nullptr)
+    if (!has_target ())
       return;
     QLineF line (x1, y1, x2, y2);
     load_drawing_context (s, x1, y1, sqrt ((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1)), 1);
-    _painter->drawLine (line);
+    if (geometric_picking (s)) {
+      QPainterPath path (line.p1 ());
+      path.lineTo (line.p2 ());
+      add_picking_path (s, path);
+    }
+    if (!must_paint (s, QRectF (line.p1 (), line.p2 ()).normalized ()))
+      return;
+    if (_painter != nullptr)
+      _painter->drawLine (line);
 
     if (is_in_picking_view (s)) {
       load_pick_context (s);
@@ -91,6 +114,8 @@ namespace djnn
   void
   QtBackend::draw_text (Text *t)
   {
+    if (!has_target ())
+      return;
     double x = t->x ()->get_value ();
     double y = t->y ()->get_value ();
     double dx = t->dx ()->get_value ();
@@ -98,7 +123,7 @@ namespace djnn
     int dxU = t->dxU ()->get_value ();
     int dyU = t->dyU ()->get_value ();
     int encoding = t->encoding ()->get_value ();
-    std::string text = t->text ()->get_value ();
+    const std::string &text = t->text ()->get_value ();
     QtContext *cur_context = _context_manager->get_current ();
     double dxfactor = cur_context->factor[dxU];
     double dyfactor = cur_context->factor[dyU];
@@ -122,37 +147,25 @@ namespace djnn
     double posY = y + (dy * dyfactor);
     QPointF p (posX, posY);
 
-    QString s;
-    switch (encoding)
-      {
-      case djnLatin1:
-      case djnAscii:
-        s = QString::fromLatin1 (text.c_str ());
-        break;
-      case djnUtf8:
-      default:
-        s = QString::fromUtf8 (text.c_str ());
-      }
-
     /* dummy value for width-height parameters because we do not manage
      gradient for text object
      */
     load_drawing_context (t, x, y, 1, 1);
 
-    /* Qt draws text with the outline color
-     but we want it to use the fill color */
-    QPen oldPen = cur_context->pen;
-    QPen newPen (oldPen);
-    newPen.setColor (cur_context->brush.color ());
-    if (cur_context->brush.style () == Qt::SolidPattern)
-      newPen.setStyle (Qt::SolidLine);
-    else
-      newPen.setStyle (Qt::NoPen);
-    _painter->setPen (newPen);
-    _painter->setFont (cur_context->font);
-
-    QFontMetrics fm = _painter->fontMetrics ();
-    QRect rect = fm.boundingRect (s);
+    /* the layout last drawn, unless the string or the font has changed */
+    QtTextCache *cache = static_cast<QtTextCache*> (t->cache ());
+    if (cache == nullptr || cache->encoding != encoding || cache->text != text || cache->font != cur_context->font) {
+      if (cache == nullptr) {
+        cache = new QtTextCache;
+        t->set_cache (cache);
+      }
+      cache->font = cur_context->font;
+      cache->encoding = encoding;
+      cache->text = text;
+      cache->layout = QtTextLayouts::instance ().get (cur_context->font, text, encoding);
+    }
+    const QtTextLayout &layout = *cache->layout;
+    QRect rect = layout.box;
 
     /* applying alignment attribute */
     switch (cur_context->textAnchor)
@@ -168,13 +181,31 @@ namespace djnn
       }
 
     rect.moveTo (posX, posY - rect.height ());
-    curTextX = rect.x () + fm.width (s);
-    curTextY = rect.y () + fm.height ();
+    curTextX = rect.x () + layout.advance;
+    curTextY = rect.y () + layout.height;
 
-    _painter->drawText (p, s);
+    if (geometric_picking (t))
+      _geometric_picking->add_rect (t, rect.x (), rect.y (), rect.width (), rect.height ());
+    if (!must_paint (t, rect))
+      return;
 
-    /* Don't forget to reset the old pen color */
-    _painter->setPen (oldPen);
+    if (_painter != nullptr) {
+      /* Qt draws text with the outline color
+       but we want it to use the fill color */
+      QPen oldPen = cur_context->pen;
+      QPen newPen (oldPen);
+      newPen.setColor (cur_context->brush.color ());
+      if (cur_context->brush.style () == Qt::SolidPattern)
+        newPen.setStyle (Qt::SolidLine);
+      else
+        newPen.setStyle (Qt::NoPen);
+      _painter->setPen (newPen);
+      _painter->setFont (cur_context->font);
+      _painter->drawStaticText (QPointF (p.x (), p.y () - layout.ascent), layout.glyphs);
+
+      /* Don't forget to reset the old pen color */
+      _painter->setPen (oldPen);
+    }
 
     if (is_in_picking_view (t)) {
       load_pick_context (t);
@@ -182,21 +213,61 @@ namespace djnn
     }
   }
 
+  /* the path of a Poly or a Path and its bounding box, built again only
+   * when one of its points has changed */
+  struct QtGeometry : public GeometryCache
+  {
+    QPainterPath path;
+    QRectF box;
+  };
+
+  template <typename T> static QtGeometry*
+  new_geometry (T *shape, const QPainterPath &path)
+  {
+    QtGeometry *g = new QtGeometry;
+    g->path = path;
+    g->box = path.boundingRect ();
+    shape->set_bounding_box (g->box.x (), g->box.y (), g->box.width (), g->box.height ());
+    return g;
+  }
+
+  QtGeometry*
+  QtBackend::path_geometry (Path *p)
+  {
+    if (p->invalid_cache ()) {
+      cur_path = QPainterPath ();
+      p->items ()->draw ();
+      p->set_cache (new_geometry (p, cur_path));
+    }
+    QtGeometry *g = static_cast<QtGeometry*> (p->cache ());
+    g->path.setFillRule (_context_manager->get_current ()->fillRule);
+    return g;
+  }
+
   void
   QtBackend::draw_poly (Poly* p)
   {
-    QPainterPath path;
-    cur_poly = QPolygonF ();
-    p->points ()->draw ();
-    path.addPolygon (cur_poly);
-    if (p->closed ())
-      path.closeSubpath ();
+    if (!has_target ())
+      return;
+    if (p->invalid_cache ()) {
+      QPainterPath path;
+      cur_poly = QPolygonF ();
+      p->points ()->draw ();
+      path.addPolygon (cur_poly);
+      if (p->closed ())
+        path.closeSubpath ();
+      p->set_cache (new_geometry (p, path));
+    }
+    QtGeometry *g = static_cast<QtGeometry*> (p->cache ());
+    QPainterPath &path = g->path;
     path.setFillRule (_context_manager->get_current ()->fillRule);
-    p->set_bounding_box (path.boundingRect ().x (), path.boundingRect ().y (), path.boundingRect ().width (),
-                          path.boundingRect ().height ());
-    load_drawing_context (p, path.boundingRect ().x (), path.boundingRect ().y (), path.boundingRect ().width (),
-                          path.boundingRect ().height ());
-    _painter->drawPath (path);
+    load_drawing_context (p, g->box.x (), g->box.y (), g->box.width (), g->box.height ());
+    if (geometric_picking (p))
+      add_picking_path (p, path);
+    if (!must_paint (p, g->box))
+      return;
+    if (_painter != nullptr)
+      _painter->drawPath (path);
     if (is_in_picking_view (p)) {
       load_pick_context (p);
       _picking_view->painter ()->drawPath (path);
@@ -211,18 +282,20 @@ namespace djnn
   void
   QtBackend::draw_path (Path *p)
   {
-    cur_path = QPainterPath ();
-    p->items ()->draw ();
-    cur_path.setFillRule (_context_manager->get_current ()->fillRule);
-    p->set_bounding_box (cur_path.boundingRect ().x (), cur_path.boundingRect ().y (),
-                         cur_path.boundingRect ().width (), cur_path.boundingRect ().height ());
-    load_drawing_context (p, cur_path.boundingRect ().x (), cur_path.boundingRect ().y (),
-                          cur_path.boundingRect ().width (), cur_path.boundingRect ().height ());
-    _painter->drawPath (cur_path);
+    if (!has_target ())
+      return;
+    QtGeometry *g = path_geometry (p);
+    load_drawing_context (p, g->box.x (), g->box.y (), g->box.width (), g->box.height ());
+    if (geometric_picking (p))
+      add_picking_path (p, g->path);
+    if (!must_paint (p, g->box))
+      return;
+    if (_painter != nullptr)
+      _painter->drawPath (g->path);
 
     if (is_in_picking_view (p)) {
       load_pick_context (p);
-      _picking_view->painter ()->drawPath (cur_path);
+      _picking_view->painter ()->drawPath (g->path);
     }
   }
 
@@ -374,29 +447,42 @@ namespace djnn
   void
   QtBackend::draw_rect_clip (RectangleClip *s, double x, double y, double w, double h)
   {
+    if (!has_target ())
+      return;
     load_drawing_context (s, x, y, w, h);
-    _painter->setClipRect (x, y, w, h);
+    if (geometric_picking (nullptr)) {
+      QtContext *cur_context = _context_manager->get_current ();
+      cur_context->pick_clip = _geometric_picking->add_rect (nullptr, x, y, w, h);
+    }
+    save_context ();
+    if (_painter != nullptr)
+      _painter->setClipRect (x, y, w, h);
     if (is_in_picking_view (s)) {
       load_pick_context (s);
       _picking_view->painter ()->setClipRect (x, y, w, h);
+      _picking_view->clip_to_region ();
     }
   }
 
   void
   QtBackend::draw_path_clip (Path *p)
   {
-    cur_path = QPainterPath ();
-    p->items ()->draw ();
-    cur_path.setFillRule (_context_manager->get_current ()->fillRule);
-    p->set_bounding_box (cur_path.boundingRect ().x (), cur_path.boundingRect ().y (),
-                         cur_path.boundingRect ().width (), cur_path.boundingRect ().height ());
-    load_drawing_context (p, cur_path.boundingRect ().x (), cur_path.boundingRect ().y (),
-                          cur_path.boundingRect ().width (), cur_path.boundingRect ().height ());
-    _painter->setClipPath (cur_path);
+    if (!has_target ())
+      return;
+    QtGeometry *g = path_geometry (p);
+    load_drawing_context (p, g->box.x (), g->box.y (), g->box.width (), g->box.height ());
+    if (geometric_picking (nullptr)) {
+      QtContext *cur_context = _context_manager->get_current ();
+      cur_context->pick_clip = add_picking_path (nullptr, g->path);
+    }
+    save_context ();
+    if (_painter != nullptr)
+      _painter->setClipPath (g->path);
 
     if (is_in_picking_view (p)) {
       load_pick_context (p);
-      _picking_view->painter ()->setClipPath (cur_path);
+      _picking_view->painter ()->setClipPath (g->path);
+      _picking_view->clip_to_region ();
     }
   }
 
@@ -407,27 +493,29 @@ namespace djnn
     double y = i->y ()->get_value ();
     double w = i->width ()->get_value ();
     double h = i->height ()->get_value ();
-    string path = i->path ()->get_value ();
+    if (!has_target ())
+      return;
     load_drawing_context (i, x, y, w, h);
     QRect rect (x, y, w, h);
-    QPixmap *pm;
-    if (i->invalid_cache ()) {
-      if (i->cache () != nullptr) {
-        pm = (QPixmap*) (i->cache ());
-        delete (pm); pm = nullptr;
-      }
-      QFileInfo fi (path.c_str ());
-      pm = new QPixmap (fi.absoluteFilePath ());
-      i->set_cache (pm);
-      i->set_invalid_cache (false);
-    } else {
-      pm = (QPixmap*) (i->cache ());
-    }
-    _painter->drawPixmap (rect, *pm);
+    if (geometric_picking (i))
+      _geometric_picking->add_rect (i, x, y, w, h);
+    if (!must_paint (i, rect))
+      return;
+    /* the copy scaled to the size drawn in the window, once it is ready */
+    QSize size = rect.size ();
+    if (_painter != nullptr)
+      size = _painter->worldTransform ().mapRect (QRectF (rect)).toRect ().size ();
+    shared_ptr<ImageData> data = ImageCache::instance ().get (i, size.width (), size.height ());
+    if (data != nullptr && _painter != nullptr)
+      _painter->drawImage (rect, static_cast<QtImage*> (data.get ())->image);
 
     if (is_in_picking_view (i)) {
       load_pick_context (i);
-      _picking_view->painter ()->drawPixmap (rect, *pm);
+      /* pickable by its rectangle while the file is being decoded */
+      if (data != nullptr)
+        _picking_view->painter ()->drawImage (rect, static_cast<QtImage*> (data.get ())->image);
+      else
+        _picking_view->painter ()->drawRect (rect);
     }
   }
 } /* namespace djnn */
@@ -29,25 +29,38 @@ namespace djnn
   QtContext*
   QtContextManager::get_current ()
   {
-    return _context_list.back ();
+    if (_depth == 0)
+      return &_default;
+    return &_context_list[_depth - 1];
   }
 
   void
   QtContextManager::push ()
   {
-    QtBackend::instance ()->save_context ();
-    if (_context_list.empty ())
-      _context_list.push_back (new QtContext ());
-    else {
-      _context_list.push_back (new QtContext (_context_list.back ()));
-    }
+    if (_depth == _context_list.size ())
+      _context_list.emplace_back ();
+    if (_depth == 0)
+      _context_list[0] = QtContext ();
+    else
+      _context_list[_depth] = _context_list[_depth - 1];
+    _context_list[_depth].saved = false;
+    _depth++;
+  }
+
+  void
+  QtContextManager::reset_base ()
+  {
+    _default = QtContext ();
   }
 
   void
   QtContextManager::pop ()
   {
-    _context_list.pop_back ();
-    QtBackend::instance ()->restore_context();
+    if (_depth == 0)
+      return;
+    _depth--;
+    if (_context_list[_depth].saved)
+      QtBackend::instance ()->restore_context ();
   }
 
   QtContext::QtContext () :
@@ -57,6 +70,8 @@ namespace djnn
     alpha = 1;
     fillRule = Qt::OddEvenFill;
     textAnchor = djnStartAnchor;
+    pick_clip = -1;
+    saved = false;
     DEFAULT_DPI_RES = 96;
     for (int i = 0; i < 10; i++)
       factor[i] = 1.;
@@ -68,21 +83,6 @@ namespace djnn
     //update_relative_units (); Fail at startup
   }
 
-  QtContext::QtContext (QtContext *p)
-  {
-    pen = QPen (p->pen);
-    brush = QBrush (p->brush);
-    matrix = QMatrix4x4 (p->matrix);
-    gradientTransform = QTransform (gradientTransform);
-    font = QFont (p->font);
-    alpha = p->alpha;
-    fillRule = p->fillRule;
-    textAnchor = p->textAnchor;
-    DEFAULT_DPI_RES = 96;
-    for (int i = 0; i < 10; i++)
-      factor[i] = p->factor[i];
-  }
-
   QtContext::~QtContext ()
   {
   }
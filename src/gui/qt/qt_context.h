@@ -28,9 +28,9 @@ namespace djnn
   class QtContext
   {
     friend class QtBackend;
+    friend class QtContextManager;
   public:
     QtContext ();
-    QtContext (QtContext* parent);
     virtual ~QtContext ();
   private:
     int DEFAULT_DPI_RES;
@@ -43,30 +43,41 @@ namespace djnn
     QFont font;
     double factor[10];
     int textAnchor;
+    int pick_clip; // last clip recorded for geometric picking, -1 for none
+    bool saved; // the painter state was saved, before a clip
     void update_relative_units ();
     double get_unit_factor (djnLengthUnit unit);
   };
 
+  /* The contexts of the components being drawn, in slots reused from a
+   * frame to the next: entering a component copies its parent's context,
+   * whose pen, brush and font are shared with it until they change. */
   class QtContextManager : public ContextManager
   {
   public:
     QtContextManager () :
-      ContextManager ()
+        ContextManager (), _depth (0)
     {
       ComponentObserver::instance ().add_draw_context_manager (this);
     }
-    ;
     virtual
     ~QtContextManager ()
     {
+      ComponentObserver::instance ().remove_draw_context_manager (this);
     }
-    ;
     void pop () override;
     void push () override;
     QtContext* get_current ();
+    size_t depth () { return _depth; }
+    /* the context of the shapes drawn outside of any component, started
+     * again with each frame */
+    QtContext* base () { return &_default; }
+    void reset_base ();
 
   private:
-    vector<QtContext*> _context_list;
+    vector<QtContext> _context_list;
+    size_t _depth;
+    QtContext _default; // for the shapes drawn outside of any component
   };
 
 } /* namespace djnn */
@@ -15,6 +15,7 @@
 #include "../backend.h"
 
 #include "../../core/syshook/main_loop.h"
+#include "../../core/syshook/event_queue.h"
 #include "qt_mainloop.h"
 
 //#include <QThread>
@@ -50,10 +51,13 @@ namespace djnn
     QObject::connect (_qevtdispatcher, &QAbstractEventDispatcher::aboutToBlock,
                       [=]() {this->slot_for_about_to_block();});
     QObject::connect (_qevtdispatcher, &QAbstractEventDispatcher::awake, [=]() {this->slot_for_awake();});
+    /* Qt runs the main loop: the wake-up hook is ours */
+    EventQueue::instance ().set_wakeup ([this] () { wakeup (); });
   }
 
   QtMainloop::~QtMainloop ()
   {
+    EventQueue::instance ().set_wakeup (nullptr);
     _qapp->quit ();
   }
   void
@@ -93,6 +97,10 @@ namespace djnn
   QtMainloop::slot_for_about_to_block ()
   {
     //DBG;
+    EventQueue::instance ().drain (); // executes the graph if any event
+    for (auto w : _windows) {
+      w->notify_damage ();
+    }
     if (_please_exec) {
       GRAPH_EXEC;
       _please_exec = false;
@@ -43,7 +43,8 @@ namespace djnn
   int
   QtPickingView::get_pixel (int x, int y)
   {
-    if (x < 0 || x >= _image->width () || y < 0 || y >= _image->height ())
+    /* the image is only there once a picking pass has drawn it */
+    if (_image == nullptr || x < 0 || x >= _image->width () || y < 0 || y >= _image->height ())
       return -1;
     return _image->pixel (x, y);
   }
@@ -52,21 +53,55 @@ namespace djnn
   QtPickingView::init ()
   {
     ColorPickingView::init ();
-    double w = _win->width ()->get_value ();
-    double h = _win->height ()->get_value ();
-    if (_painter != nullptr)
-      delete _painter;
-    if (_image != nullptr)
-      delete _image;
-    _image = new QImage (w, h, QImage::Format_RGB32);
+    int w = _win->width ()->get_value ();
+    int h = _win->height ()->get_value ();
+    /* the image is kept until the window is resized */
+    if (_image == nullptr || _image->width () != w || _image->height () != h) {
+      if (_painter != nullptr)
+        delete _painter;
+      if (_image != nullptr)
+        delete _image;
+      _image = new QImage (w, h, QImage::Format_RGB32);
+      _painter = new QPainter (_image);
+    } else {
+      _painter->setClipping (false);
+      _painter->resetTransform ();
+    }
     _image->fill (0xffffffff);
-    _painter = new QPainter (_image);
+    _region = QRegion ();
+  }
+
+  bool
+  QtPickingView::init (const QRegion &r)
+  {
+    int w = _win->width ()->get_value ();
+    int h = _win->height ()->get_value ();
+    if (_image == nullptr || _image->width () != w || _image->height () != h) {
+      init ();
+      return false;
+    }
+    _painter->setClipping (false);
+    _painter->resetTransform ();
+    _painter->setCompositionMode (QPainter::CompositionMode_Source);
+    for (const QRect &rect : r.rects ())
+      _painter->fillRect (rect, QColor::fromRgba (0xffffffff));
+    _painter->setCompositionMode (QPainter::CompositionMode_SourceOver);
+    _painter->setClipRegion (r);
+    _region = r;
+    return true;
+  }
+
+  void
+  QtPickingView::clip_to_region ()
+  {
+    if (!_region.isEmpty ())
+      _painter->setClipRegion (_region, Qt::IntersectClip);
   }
 
   void
   QtPickingView::display ()
   {
-    if (_pick_debug_win == nullptr)
+    if (_pick_debug_win == nullptr || _image == nullptr)
       return;
     double w = _win->width ()->get_value ();
     double h = _win->height ()->get_value ();
@@ -23,6 +23,7 @@
 #include <map>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
+#include <QtGui/QRegion>
 #include <QtWidgets/QLabel>
 
 namespace djnn
@@ -35,10 +36,16 @@ namespace djnn
     virtual
     ~QtPickingView ();
     virtual void init ();
+    /* keeps the picking image outside of r, returns false if it had to be
+     * started again */
+    bool init (const QRegion &r);
+    /* after a clip shape, so that a partial frame stays inside its region */
+    void clip_to_region ();
     virtual int get_pixel(int x, int y);
     QPainter* painter () { return _painter; }
     void display ();
   private:
+    QRegion _region;
     QLabel *_pick_debug_win;
     QImage *_image;
     QPainter *_painter;
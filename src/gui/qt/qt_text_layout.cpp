@@ -0,0 +1,75 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "qt_text_layout.h"
+
+#include <QtGui/QFontMetrics>
+#include <QtGui/QTransform>
+
+namespace djnn
+{
+  using namespace std;
+
+  QtTextLayouts* QtTextLayouts::_instance;
+  std::once_flag QtTextLayouts::onceFlag;
+
+  QtTextLayouts&
+  QtTextLayouts::instance ()
+  {
+    std::call_once (QtTextLayouts::onceFlag, [] () {
+      _instance = new QtTextLayouts ();
+    });
+
+    return *(_instance);
+  }
+
+  shared_ptr<QtTextLayout>
+  QtTextLayouts::get (const QFont &font, const string &text, int encoding)
+  {
+    string key = font.key ().toStdString () + '\n' + to_string (encoding) + '\n' + text;
+    std::lock_guard<std::mutex> lock (_mutex);
+    auto it = _index.find (key);
+    if (it != _index.end ()) {
+      _lru.splice (_lru.begin (), _lru, it->second);
+      return it->second->second;
+    }
+    QString s;
+    switch (encoding)
+      {
+      case djnLatin1:
+      case djnAscii:
+        s = QString::fromLatin1 (text.c_str ());
+        break;
+      case djnUtf8:
+      default:
+        s = QString::fromUtf8 (text.c_str ());
+      }
+    shared_ptr<QtTextLayout> layout = make_shared<QtTextLayout> ();
+    QFontMetrics fm (font);
+    layout->box = fm.boundingRect (s);
+    layout->advance = fm.width (s);
+    layout->height = fm.height ();
+    layout->ascent = fm.ascent ();
+    layout->glyphs.setTextFormat (Qt::PlainText);
+    layout->glyphs.setText (s);
+    layout->glyphs.prepare (QTransform (), font);
+    _lru.push_front (entry_t (key, layout));
+    _index[key] = _lru.begin ();
+    if (_lru.size () > max_layouts) {
+      _index.erase (_lru.back ().first);
+      _lru.pop_back ();
+    }
+    return layout;
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "../shapes/shapes.h"
+
+#include <QtGui/QFont>
+#include <QtGui/QStaticText>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace djnn
+{
+  /* a string shaped with a font, with its metrics */
+  struct QtTextLayout
+  {
+    QStaticText glyphs; // drawn from the top left corner
+    QRect box; // bounding rectangle, from the baseline at the origin
+    int advance;
+    int height;
+    int ascent;
+  };
+
+  /* The layouts of the strings drawn recently, keyed by font and string,
+   * and shared by the Texts showing the same string. Past max_layouts, the
+   * least recently used are dropped, those still held by a Text staying
+   * alive. */
+  class QtTextLayouts
+  {
+  public:
+    static QtTextLayouts& instance ();
+    std::shared_ptr<QtTextLayout> get (const QFont &font, const std::string &text, int encoding);
+
+  private:
+    QtTextLayouts () {}
+    typedef std::pair<std::string, std::shared_ptr<QtTextLayout> > entry_t;
+    static const size_t max_layouts = 4096;
+    static QtTextLayouts* _instance;
+    static std::once_flag onceFlag;
+    std::mutex _mutex;
+    std::list<entry_t> _lru; // the most recently used first
+    std::unordered_map<std::string, std::list<entry_t>::iterator> _index;
+  };
+
+  /* the layout last drawn by a Text, used as long as neither its string
+   * nor its font change */
+  struct QtTextCache : public GeometryCache
+  {
+    QFont font;
+    int encoding;
+    std::string text;
+    std::shared_ptr<QtTextLayout> layout;
+  };
+}
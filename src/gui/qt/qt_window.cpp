@@ -47,7 +47,7 @@ namespace djnn
   int full_screen = 0;
 
   QtWindow::QtWindow (Window *win, const std::string& title, double x, double y, double w, double h) :
-      _qwidget (nullptr), _window (win), _please_update (true)
+      _qwidget (nullptr), _window (win), _please_update (true), _damage_to_notify (false), _picking_mode (COLOR_PICKING), _full_colors (0)
   {
   }
 
@@ -94,12 +94,94 @@ namespace djnn
     QtMainloop::instance ().wakeup (); // ... and wake up qt
   }
 
+  void
+  QtWindow::set_picking_mode (picking_mode_t m)
+  {
+    if (m == _picking_mode)
+      return;
+    _picking_mode = m;
+    /* the picking view left is not up to date any more */
+    _window->damage ().add_all ();
+    update ();
+  }
+
+  void
+  QtWindow::update_picking ()
+  {
+    DamageRegion &pick = _window->pick_damage ();
+    Process *p = _window->get_parent ();
+    if (pick.empty () || _qwidget == nullptr || _picking_mode != COLOR_PICKING)
+      return;
+    QtPickingView *view = _qwidget->picking_view ();
+    /* the colors of the shapes gone are only released when it is drawn whole */
+    if (view->num_colors () > 2 * _full_colors + 256)
+      pick.add_all ();
+    if (!pick.all ()) {
+      QRegion region;
+      for (auto &r : pick.rects ())
+        region += QRect (r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0);
+      if (!view->init (region))
+        pick.add_all ();
+    } else
+      view->init ();
+    QtBackend* backend = dynamic_cast<QtBackend*> (Backend::instance ());
+    backend->set_window (_window);
+    backend->set_painter (nullptr);
+    backend->set_picking_view (view);
+    backend->set_damage_pass (AbstractBackend::PICKING_PASS);
+    if (p)
+      p->draw ();
+    backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+    backend->set_picking_view (nullptr);
+    if (pick.all ())
+      _full_colors = view->num_colors ();
+    pick.clear ();
+  }
+
   void
   QtWindow::check_for_update ()
   {
-    if (_please_update) {
+    if (!_please_update)
+      return;
+    _please_update = false;
+    /* the shapes that changed are found without painting anything, Qt is
+     * then asked to repaint their boxes only */
+    DamageRegion &damage = _window->damage ();
+    Process *p = _window->get_parent ();
+    if (p && !damage.all ()) {
+      QtBackend* backend = dynamic_cast<QtBackend*> (Backend::instance ());
+      backend->set_window (_window);
+      backend->set_painter (nullptr);
+      /* the geometry of the shapes is picked up on the way */
+      GeometricPicking *g = dynamic_cast<GeometricPicking*> (_qwidget->picking ());
+      if (g)
+        g->init ();
+      backend->set_picking_view (g);
+      backend->set_damage_pass (AbstractBackend::BOUNDS_PASS);
+      p->draw ();
+      backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+      backend->set_picking_view (nullptr);
+    }
+    if (damage.all ())
       _qwidget->update ();
-      _please_update = false;
+    else if (!damage.empty ()) {
+      QRegion region;
+      for (auto &r : damage.rects ())
+        region += QRect (r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0);
+      _qwidget->update (region);
+    }
+  }
+
+  void
+  QtWindow::notify_damage ()
+  {
+    if (!_damage_to_notify)
+      return;
+    _damage_to_notify = false;
+    DoubleProperty *area = _window->damaged_area ();
+    if (area->is_activable () && area->has_coupling ()) {
+      area->notify_activation ();
+      QtMainloop::instance ().set_please_exec (true);
     }
   }
 
@@ -124,17 +206,17 @@ namespace djnn
                 continue;
               case Qt::TouchPointPressed:
                 {
-                  exec_ |= _picking_view->genericTouchPress (x, y, id);
+                  exec_ |= picking ()->genericTouchPress (x, y, id);
                   break;
                 }
               case Qt::TouchPointMoved:
                 {
-                  exec_ |= _picking_view->genericTouchMove (x, y, id);
+                  exec_ |= picking ()->genericTouchMove (x, y, id);
                   break;
                 }
               case Qt::TouchPointReleased:
                 {
-                  exec_ |= _picking_view->genericTouchRelease (x, y, id);
+                  exec_ |= picking ()->genericTouchRelease (x, y, id);
                   break;
                 }
               }
@@ -205,7 +287,7 @@ namespace djnn
 //DBG;
     mouse_pos_x = event->x ();
     mouse_pos_y = event->y ();
-    bool exec_ = _picking_view->genericMousePress (mouse_pos_x, mouse_pos_y, event->button ());
+    bool exec_ = picking ()->genericMousePress (mouse_pos_x, mouse_pos_y, event->button ());
     if (exec_)
       QtMainloop::instance ().set_please_exec (true);
   }
@@ -215,7 +297,7 @@ namespace djnn
   {
     mouse_pos_x = event->x ();
     mouse_pos_y = event->y ();
-    bool exec_ = _picking_view->genericMouseMove (mouse_pos_x, mouse_pos_y);
+    bool exec_ = picking ()->genericMouseMove (mouse_pos_x, mouse_pos_y);
     if (exec_)
       QtMainloop::instance ().set_please_exec (true);
   }
@@ -226,7 +308,7 @@ namespace djnn
     mouse_pos_x = event->x ();
     mouse_pos_y = event->y ();
 
-    bool exec_ = _picking_view->genericMouseRelease (mouse_pos_x, mouse_pos_y, event->button ());
+    bool exec_ = picking ()->genericMouseRelease (mouse_pos_x, mouse_pos_y, event->button ());
     if (exec_)
       QtMainloop::instance ().set_please_exec (true);
   }
@@ -239,7 +321,7 @@ namespace djnn
     double dy = fdelta.y () / 8;
     if (dx == 0 && dy == 0) // some trackpads seem to send a lot of unwanted zero values
       return;
-    bool exec_ = _picking_view->genericMouseWheel (dx, dy);  // the angle is in eights of a degree
+    bool exec_ = picking ()->genericMouseWheel (dx, dy);  // the angle is in eights of a degree
     if (exec_)
       QtMainloop::instance ().set_please_exec (true);
   }
@@ -261,9 +343,27 @@ namespace djnn
     backend->set_window (_window);
     QPainter painter (this);
     backend->set_painter (&painter);
-    backend->set_picking_view (_picking_view);
+    /* the color picking view is drawn by update_picking, when a pick needs it */
+    Picking *picking_view = picking ();
+    bool geometric = picking_view == _geometric_picking;
+    backend->set_picking_view (geometric ? picking_view : nullptr);
     Process *p = _window->get_parent ();
-    _picking_view->init ();
+
+    /* Qt may ask for more than what changed, when the window is exposed */
+    DamageRegion &damage = _window->damage ();
+    damage.clear ();
+    QRegion region = event->region ();
+    /* a partial frame keeps the geometry recorded by the bounds pass */
+    if ((QRegion (rect ()) - region).isEmpty ()) {
+      damage.add_all ();
+      if (geometric)
+        _geometric_picking->init ();
+      backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+    } else {
+      for (const QRect &r : region.rects ())
+        damage.add (r.x (), r.y (), r.width (), r.height ());
+      backend->set_damage_pass (AbstractBackend::PARTIAL_REPAINT);
+    }
     if (p) {
 #if _PERF_TEST
       t1();
@@ -277,7 +377,15 @@ namespace djnn
       cerr << "DRAW : " << draw_counter << " - avg: " << draw_average << endl; 
 #endif
     }
-    if (_picking_view->genericCheckShapeAfterDraw (mouse_pos_x, mouse_pos_y))
+    backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+    /* the painter goes with the event */
+    backend->set_painter (nullptr);
+    /* propagated from the main loop once the paint is done: a binding on it
+     * may well damage the window again */
+    _window->damaged_area ()->set_value (damage.area (width (), height ()), false);
+    _qtwindow->_damage_to_notify = true;
+    damage.clear ();
+    if (picking_view->genericCheckShapeAfterDraw (mouse_pos_x, mouse_pos_y))
       QtMainloop::instance ().set_please_exec (true);
 #if DEBUG
     _picking_view->display();
@@ -35,7 +35,12 @@ namespace djnn {
     virtual ~QtWindow ();
     void update () override;
     void check_for_update ();
+    /* announces the area painted by the last paintEvent, out of it */
+    void notify_damage ();
     MyQWidget* qwidget() { return _qwidget; }
+    void set_picking_mode (picking_mode_t m) override;
+    void update_picking () override;
+    picking_mode_t picking_mode () { return _picking_mode; }
 
   protected:
     // Process
@@ -48,6 +53,10 @@ namespace djnn {
     MyQWidget * _qwidget;
     Window* _window;
     bool _please_update;
+    bool _damage_to_notify;
+    picking_mode_t _picking_mode;
+    /* colors in the picking view after it was last drawn whole */
+    size_t _full_colors;
     friend class MyQWidget;
   };
 
@@ -23,6 +23,7 @@ namespace djnn
       Container (p, n), _gobj (nullptr)
   {
     _cpnt_type = GOBJ;
+    set_main_thread_only ();
     _gobj = new AbstractGObj (this, "");
     Process::finalize ();
   }
@@ -31,6 +32,7 @@ namespace djnn
       Container (), _gobj (nullptr)
   {
     _cpnt_type = GOBJ;
+    set_main_thread_only ();
     _gobj = new AbstractGObj (this, "");
   }
 
@@ -15,19 +15,18 @@
 #include "../backend.h"
 #include "../abstract_backend.h"
 #include "shapes.h"
+#include "../image_cache.h"
 #include "../../core/control/coupling.h"
 
 namespace djnn
 {
-  Image::Image (const std::string& path, double x, double y, double w, double h) :
-      _invalid_cache (true)
+  Image::Image (const std::string& path, double x, double y, double w, double h)
   {
     _x = new DoubleProperty (this, "x", x);
     _y = new DoubleProperty (this, "y", y);
     _width = new DoubleProperty (this, "width", w);
     _height = new DoubleProperty (this, "height", h);
     _path = new TextProperty (this, "path", path);
-    set_cache (nullptr);
     Process *update = UpdateDrawing::instance ()->get_damaged ();
     _cx = new Coupling (_x, ACTIVATION, update, ACTIVATION);
     _cx->disable ();
@@ -37,22 +36,20 @@ namespace djnn
     _cwidth->disable ();
     _cheight = new Coupling (_height, ACTIVATION, update, ACTIVATION);
     _cheight->disable ();
-    _watcher = new ImageWatcher (this);
-    _cpath = new Coupling (_path, ACTIVATION, _watcher, ACTIVATION);
+    _cpath = new Coupling (_path, ACTIVATION, update, ACTIVATION);
     _cpath->disable ();
     set_origin (x, y);
   }
 
   Image::Image (Process *p, const std::string& n, const std::string& path, double x, double y, double w,
 		double h) :
-      AbstractGShape (p, n), _invalid_cache (true)
+      AbstractGShape (p, n)
   {
     _x = new DoubleProperty (this, "x", x);
     _y = new DoubleProperty (this, "y", y);
     _width = new DoubleProperty (this, "width", w);
     _height = new DoubleProperty (this, "height", h);
     _path = new TextProperty (this, "path", path);
-    set_cache (nullptr);
     Process *update = UpdateDrawing::instance ()->get_damaged ();
     _cx = new Coupling (_x, ACTIVATION, update, ACTIVATION);
     _cx->disable ();
@@ -62,8 +59,7 @@ namespace djnn
     _cwidth->disable ();
     _cheight = new Coupling (_height, ACTIVATION, update, ACTIVATION);
     _cheight->disable ();
-    _watcher = new ImageWatcher (this);
-    _cpath = new Coupling (_path, ACTIVATION, _watcher, ACTIVATION);
+    _cpath = new Coupling (_path, ACTIVATION, update, ACTIVATION);
     _cpath->disable ();
     set_origin (x, y);
     Process::finalize ();
@@ -71,12 +67,12 @@ namespace djnn
 
   Image::~Image ()
   {
+    ImageCache::instance ().forget (this);
     if (_cx) {delete _cx; _cx = nullptr;}
     if (_cy) {delete _cy; _cy = nullptr;}
     if (_cwidth) {delete _cwidth; _cwidth = nullptr;}
     if (_cheight) {delete _cheight; _cheight = nullptr;}
     if (_cpath) {delete _cpath; _cpath = nullptr;}
-    if (_watcher) {delete _watcher; _watcher = nullptr;}
     if (_x) {delete _x; _x = nullptr;}
     if (_y) {delete _y; _y = nullptr;}
     if (_width) {delete _width; _width = nullptr;}
@@ -106,6 +102,16 @@ namespace djnn
     _cpath->disable ();
   }
 
+  void
+  Image::redraw ()
+  {
+    if (_activation_state > activated || _frame == nullptr)
+      return;
+    damage ();
+    UpdateDrawing::instance ()->add_window_for_refresh (_frame);
+    UpdateDrawing::instance ()->get_damaged ()->notify_activation ();
+  }
+
   void
   Image::draw ()
   {
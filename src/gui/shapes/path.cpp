@@ -469,7 +469,7 @@ namespace djnn
   }
 
   Path::Path () :
-      AbstractGShape ()
+      AbstractGShape (), _cache (nullptr), _invalid_cache (true)
   {
     _items = new List (this, "items");
     _bounding_box = new Blank (this, "bounding_box");
@@ -484,7 +484,7 @@ namespace djnn
   }
 
   Path::Path (Process* p, const string &n) :
-      AbstractGShape (p, n)
+      AbstractGShape (p, n), _cache (nullptr), _invalid_cache (true)
   {
     _items = new List (this, "items");
     _bounding_box = new Blank (this, "bounding_box");
@@ -501,7 +501,13 @@ namespace djnn
 
   Path::~Path ()
   {
-    delete _items;
+    if (_cache) {delete _cache; _cache = nullptr;}
+    if (_bbh) {delete _bbh; _bbh = nullptr;}
+    if (_bbw) {delete _bbw; _bbw = nullptr;}
+    if (_bby) {delete _bby; _bby = nullptr;}
+    if (_bbx) {delete _bbx; _bbx = nullptr;}
+    if (_bounding_box) {delete _bounding_box; _bounding_box = nullptr;}
+    if (_items) {delete _items; _items = nullptr;}
   }
 
   void
@@ -92,7 +92,7 @@ namespace djnn
   }
 
   Poly::Poly (int closed) :
-      AbstractGShape (), _closed (closed)
+      AbstractGShape (), _closed (closed), _cache (nullptr), _invalid_cache (true)
   {
     _points = new List (this, "points");
     _bounding_box = new Blank (this, "bounding_box");
@@ -107,7 +107,7 @@ namespace djnn
   }
 
   Poly::Poly (Process* p, const string &n, int closed) :
-      AbstractGShape (p, n), _closed (closed)
+      AbstractGShape (p, n), _closed (closed), _cache (nullptr), _invalid_cache (true)
   {
     _points = new List (this, "points");
     _bounding_box = new Blank (this, "bounding_box");
@@ -124,6 +124,7 @@ namespace djnn
 
   Poly::~Poly ()
   {
+    if (_cache) {delete _cache; _cache = nullptr;}
     if (_bbh) {delete _bbh; _bbh = nullptr;}
     if (_bbw) {delete _bbw; _bbw = nullptr;}
     if (_bby) {delete _bby; _bby = nullptr;}
@@ -24,6 +24,14 @@
 
 namespace djnn
 {
+  /* the geometry of a Poly or a Path as built by the backend, kept until
+   * one of its points changes, or the layout of a Text, checked by the
+   * backend against the string and the font it is drawn with */
+  class GeometryCache
+  {
+  public:
+    virtual ~GeometryCache () {}
+  };
 
   class Rectangle : public AbstractGShape
   {
@@ -89,6 +97,8 @@ namespace djnn
     void set_height (double height) { _height->set_value (height, true);}
     IntProperty*    encoding () { return _encoding;}
     TextProperty*   text (){ return _text;}
+    GeometryCache* cache () { return _cache;}
+    void set_cache (GeometryCache *cache) { if (_cache) {delete _cache;} _cache = cache;}
   private:
     DoubleProperty *_x;
     DoubleProperty *_y;
@@ -105,6 +115,7 @@ namespace djnn
     DoubleProperty *_fsize;
     IntProperty *_fstyle, *_fweight;
     TextSizeAction *_update_size;
+    GeometryCache *_cache;
     void init_text (double x, double y, const std::string &text);
     void activate () override;
     void deactivate () override;
@@ -183,6 +194,10 @@ namespace djnn
     void draw () override;
     Process* clone () override;
     void set_bounding_box (double x, double y, double w, double h);
+    GeometryCache* cache () { return _cache;}
+    void set_cache (GeometryCache *cache) { if (_cache) {delete _cache;} _cache = cache; _invalid_cache = false;}
+    bool invalid_cache () { return _invalid_cache || _cache == nullptr;}
+    void set_invalid_cache (bool v) { _invalid_cache = v;}
   protected:
     void activate () override;
     void deactivate () override;
@@ -191,6 +206,8 @@ namespace djnn
     Process* _bounding_box;
     DoubleProperty *_bbx, *_bby, *_bbw, *_bbh;
     bool _closed;
+    GeometryCache *_cache;
+    bool _invalid_cache;
   };
 
   class Polygon : public Poly
@@ -340,12 +357,18 @@ namespace djnn
     void draw () override;
     Process* clone () override;
     void set_bounding_box (double x, double y, double w, double h);
+    GeometryCache* cache () { return _cache;}
+    void set_cache (GeometryCache *cache) { if (_cache) {delete _cache;} _cache = cache; _invalid_cache = false;}
+    bool invalid_cache () { return _invalid_cache || _cache == nullptr;}
+    void set_invalid_cache (bool v) { _invalid_cache = v;}
   protected:
     void activate () override;
     void deactivate () override;
     List *_items;
     Process* _bounding_box;
     DoubleProperty *_bbx, *_bby, *_bbw, *_bbh;
+    GeometryCache *_cache;
+    bool _invalid_cache;
   };
 
   class PathClip : public Path
@@ -360,8 +383,6 @@ namespace djnn
     Process* clone () override;
   };
 
-  class ImageWatcher;
-
   class Image : public AbstractGShape
   {
   public:
@@ -375,10 +396,8 @@ namespace djnn
     DoubleProperty* width () { return _width;}
     DoubleProperty* height () { return _height;}
     TextProperty* path () { return _path;}
-    void* cache () { return _cache;}
-    void set_cache (void * cache) { _cache = cache;}
-    bool invalid_cache () { return _invalid_cache;}
-    void set_invalid_cache (bool v) { _invalid_cache = v;}
+    /* once its file is decoded, from the thread of the image cache */
+    void redraw ();
   private:
     DoubleProperty *_x;
     DoubleProperty *_y;
@@ -386,26 +405,8 @@ namespace djnn
     DoubleProperty *_height;
     TextProperty *_path;
     Coupling *_cx, *_cy, *_cwidth, *_cheight, *_cpath;
-    ImageWatcher *_watcher;
     void activate () override;
     void deactivate () override;
-    void *_cache;
-    bool _invalid_cache;
-  };
-
-  class ImageWatcher : public Process
-  {
-  public:
-    ImageWatcher (Image *i) :
-        Process (), _img (i) {}
-    virtual ~ImageWatcher () {}
-    void activate () override
-    {
-      _img->set_invalid_cache (true);
-    }
-    void deactivate () override {};
-  private:
-    Image * _img;
   };
 
   class Ellipse : public AbstractGShape
@@ -59,7 +59,7 @@ namespace djnn
 
   Text::Text (Process *p, const std::string& n, double x, double y, const std::string &text) :
       AbstractGShape (p, n), _text (nullptr), _cx (nullptr), _cy (nullptr), _cffamily (nullptr), _cfsize (nullptr), _cfstyle (
-          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr)
+          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr), _cache (nullptr)
   {
     init_text (x, y, text);
   }
@@ -67,7 +67,7 @@ namespace djnn
   Text::Text (Process *p, const std::string& n, double x, double y, double dx, double dy, int dxu, int dyu,
               const std::string &encoding, const std::string &text) :
       AbstractGShape (p, n), _text (nullptr), _cx (nullptr), _cy (nullptr), _cffamily (nullptr), _cfsize (nullptr), _cfstyle (
-          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr)
+          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr), _cache (nullptr)
   {
     _x = new DoubleProperty (this, "x", x);
     _y = new DoubleProperty (this, "y", y);
@@ -102,14 +102,14 @@ namespace djnn
 
   Text::Text (double x, double y, const std::string &text) :
       AbstractGShape (), _text (nullptr), _cx (nullptr), _cy (nullptr), _cffamily (nullptr), _cfsize (nullptr), _cfstyle (
-          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr)
+          nullptr), _cfweight (nullptr), _ffamily (nullptr), _fsize (nullptr), _fstyle (nullptr), _fweight (nullptr), _cache (nullptr)
   {
     init_text (x, y, text);
   }
 
   Text::~Text ()
   {
-    
+    if (_cache) {delete _cache; _cache = nullptr;}
     Graph::instance ().remove_edge (_text, _update_size);
     if (_parent && _parent->state_dependency () != nullptr)
       Graph::instance ().remove_edge (_parent->state_dependency (), _update_size);
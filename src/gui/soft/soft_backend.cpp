@@ -0,0 +1,429 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "../backend.h"
+#include "../transformation/transformations.h"
+#include "soft_context.h"
+#include "soft_backend.h"
+#include "soft_window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace djnn
+{
+  SoftBackend *SoftBackend::_instance;
+  std::once_flag SoftBackend::onceFlag;
+
+  SoftBackend*
+  SoftBackend::instance ()
+  {
+    std::call_once (SoftBackend::onceFlag, [] () {
+      _instance = new SoftBackend();
+    });
+
+    return _instance;
+  }
+
+  SoftBackend::SoftBackend () :
+      _pixels (nullptr), _width (0), _height (0), _picking_view (nullptr), _geometric_picking (nullptr)
+  {
+    _context_manager = new SoftContextManager ();
+    /* the image is sampled through the whole transformation when drawn,
+     * a copy scaled beforehand would save nothing */
+    ImageCache::instance ().set_codec ([] (const string &path) -> ImageData* {
+      SoftImage *img = load_pnm (path);
+      return img != nullptr ? new SoftImageData (img) : nullptr;
+    }, nullptr);
+  }
+
+  SoftBackend::~SoftBackend ()
+  {
+    if (_context_manager) { delete _context_manager; _context_manager = nullptr;}
+  }
+
+  void
+  SoftBackend::set_target (uint8_t *pixels, int width, int height)
+  {
+    /* each pass starts and ends here: the clip or the transform left by
+     * the shapes drawn outside of any component don't outlive it */
+    _context_manager->reset_base ();
+    _pixels = pixels;
+    _width = width;
+    _height = height;
+  }
+
+  void
+  SoftBackend::set_picking_view (Picking* p)
+  {
+    _picking_view = dynamic_cast<SoftPickingView*> (p);
+    _geometric_picking = dynamic_cast<GeometricPicking*> (p);
+  }
+
+  WinImpl*
+  SoftBackend::create_window (Window *win, const std::string& title, double x, double y, double w, double h)
+  {
+    return new SoftWindow (win, title, x, y, w, h);
+  }
+
+  bool
+  SoftBackend::is_in_picking_view (AbstractGShape *s)
+  {
+    return _picking_view != nullptr && is_pickable (s);
+  }
+
+  /* the geometry is recorded by the passes that go through all the shapes,
+   * in paint order; a partial repaint keeps what the bounds pass recorded */
+  GeometricPicking*
+  SoftBackend::geometric_picking (AbstractGShape *s)
+  {
+    if (_geometric_picking == nullptr || _damage_pass == PARTIAL_REPAINT || (s != nullptr && !is_pickable (s)))
+      return nullptr;
+    SoftContext *cur_context = _context_manager->get_current ();
+    const affine_t &m = cur_context->matrix;
+    _geometric_picking->set_matrix (m.a, m.b, m.c, m.d, m.e, m.f);
+    _geometric_picking->set_half_stroke (s == nullptr ? 0 : current_stroke (cur_context).width / 2 / m.scale ());
+    /* a clip replaces the previous one */
+    _geometric_picking->set_clip (s == nullptr ? -1 : cur_context->pick_clip);
+    return _geometric_picking;
+  }
+
+  /* flattened in the window, where the tolerance is known */
+  int
+  SoftBackend::add_picking_path (AbstractGShape *s, const SoftPath &path)
+  {
+    GeometricPicking *g = geometric_picking (s);
+    if (g == nullptr)
+      return -1;
+    SoftContext *cur_context = _context_manager->get_current ();
+    _lines.clear ();
+    _closed.clear ();
+    path.flatten (cur_context->matrix, _lines, _closed);
+    vector<vector<double> > subpaths (_lines.size ());
+    for (size_t i = 0; i < _lines.size (); i++)
+      for (auto &p : _lines[i]) {
+        subpaths[i].push_back (p.x);
+        subpaths[i].push_back (p.y);
+      }
+    g->set_matrix (1, 0, 0, 1, 0, 0);
+    g->set_half_stroke (s == nullptr ? 0 : current_stroke (cur_context).width / 2);
+    return g->add_path (s, subpaths, _closed, cur_context->even_odd);
+  }
+
+  /* the local coordinates of the pointer are computed from this matrix */
+  void
+  SoftBackend::load_drawing_context (AbstractGShape *s)
+  {
+    const affine_t &m = _context_manager->get_current ()->matrix;
+    s->set_ctm (m.a, m.b, m.c, m.d, m.e, m.f);
+  }
+
+  static inline float
+  clipped (float coverage, const vector<uint8_t> *clip, size_t i)
+  {
+    coverage = std::min (coverage, 1.f);
+    if (clip != nullptr)
+      coverage *= (*clip)[i] * (1.f / 255);
+    return coverage;
+  }
+
+  /* source over, on non-premultiplied pixels */
+  void
+  SoftBackend::blend (uint8_t *p, const soft_color_t &c, float coverage)
+  {
+    float sa = c.a * coverage;
+    if (sa <= 0)
+      return;
+    float da = p[3] * (1.f / 255);
+    float oa = sa + da * (1 - sa);
+    float k = da * (1 - sa);
+    p[0] = (c.r * sa + p[0] * k) / oa + 0.5f;
+    p[1] = (c.g * sa + p[1] * k) / oa + 0.5f;
+    p[2] = (c.b * sa + p[2] * k) / oa + 0.5f;
+    p[3] = oa * 255 + 0.5f;
+  }
+
+  Rasterizer::span_func_t
+  SoftBackend::color_span (SoftContext *ctx, const soft_color_t &c)
+  {
+    shared_ptr<vector<uint8_t> > clip = ctx->clip;
+    return [this, c, clip] (int y, int x0, int x1, const float *cov) {
+      uint8_t *row = _pixels + (size_t) y * _width * 4;
+      for (int x = x0; x < x1; x++) {
+        float a = clipped (cov[x], clip.get (), (size_t) y * _width + x);
+        if (a > 0)
+          blend (row + x * 4, c, a);
+      }
+    };
+  }
+
+  /* the paint is evaluated at the center of each pixel, mapped back into
+   * the gradient or the texture space */
+  Rasterizer::span_func_t
+  SoftBackend::paint_span (SoftContext *ctx, double x, double y, double w, double h)
+  {
+    shared_ptr<vector<uint8_t> > clip = ctx->clip;
+    switch (ctx->fill_type)
+      {
+      case SOFT_SOLID_FILL:
+        return color_span (ctx, ctx->fill_color);
+      case SOFT_LINEAR_FILL:
+      case SOFT_RADIAL_FILL:
+        {
+          shared_ptr<SoftGradient> g = ctx->gradient;
+          affine_t norm;
+          if (g->bounding_box_units) {
+            if (w == 0 || h == 0)
+              return nullptr;
+            norm = affine_t (1 / w, 0, 0, 1 / h, -x / w, -y / h);
+          }
+          affine_t to_gradient = g->transform.inverted () * norm * ctx->matrix.inverted ();
+          /* the focus is kept inside the circle */
+          double fdx = g->fx - g->cx, fdy = g->fy - g->cy, fd = hypot (fdx, fdy);
+          if (fd > g->r * 0.99 && fd > 0) {
+            fdx *= g->r * 0.99 / fd;
+            fdy *= g->r * 0.99 / fd;
+          }
+          double fx = g->cx + fdx, fy = g->cy + fdy;
+          double A = fdx * fdx + fdy * fdy - g->r * g->r;
+          return [this, g, to_gradient, clip, fx, fy, fdx, fdy, A] (int y, int x0, int x1, const float *cov) {
+            uint8_t *row = _pixels + (size_t) y * _width * 4;
+            for (int x = x0; x < x1; x++) {
+              float a = clipped (cov[x], clip.get (), (size_t) y * _width + x);
+              if (a <= 0)
+                continue;
+              double gx, gy, t;
+              to_gradient.apply (x + 0.5, y + 0.5, gx, gy);
+              if (g->linear) {
+                double dx = g->x2 - g->x1, dy = g->y2 - g->y1, l2 = dx * dx + dy * dy;
+                t = l2 == 0 ? 0 : ((gx - g->x1) * dx + (gy - g->y1) * dy) / l2;
+              } else if (A >= 0)
+                t = 0;
+              else {
+                /* the point lies on the circle of center f + t (c - f) and radius t r */
+                double qx = gx - fx, qy = gy - fy;
+                double B = -(qx * fdx + qy * fdy), C = qx * qx + qy * qy;
+                t = (B - sqrt (std::max (0., B * B - A * C))) / A;
+              }
+              blend (row + x * 4, g->color_at (t), a);
+            }
+          };
+        }
+      case SOFT_TEXTURE_FILL:
+        {
+          shared_ptr<SoftImage> img = ctx->texture;
+          affine_t to_user = ctx->matrix.inverted ();
+          float alpha = ctx->fill_color.a;
+          return [this, img, to_user, clip, alpha] (int y, int x0, int x1, const float *cov) {
+            uint8_t *row = _pixels + (size_t) y * _width * 4;
+            for (int x = x0; x < x1; x++) {
+              float a = clipped (cov[x], clip.get (), (size_t) y * _width + x);
+              if (a <= 0)
+                continue;
+              double ux, uy;
+              to_user.apply (x + 0.5, y + 0.5, ux, uy);
+              /* tiled from the user space origin */
+              int ix = (int) floor (ux) % img->width, iy = (int) floor (uy) % img->height;
+              if (ix < 0)
+                ix += img->width;
+              if (iy < 0)
+                iy += img->height;
+              const uint8_t *t = &img->rgba[((size_t) iy * img->width + ix) * 4];
+              blend (row + x * 4, { (float) t[0], (float) t[1], (float) t[2], t[3] * alpha / 255 }, a);
+            }
+          };
+        }
+      default:
+        return nullptr;
+      }
+  }
+
+  void
+  SoftBackend::fill (const SoftPath &path, bool even_odd, const Rasterizer::span_func_t &span)
+  {
+    _lines.clear ();
+    _closed.clear ();
+    path.flatten (_context_manager->get_current ()->matrix, _lines, _closed);
+    _raster.reset (_width, _height);
+    for (auto &l : _lines)
+      _raster.add_polygon (l);
+    _raster.render (even_odd, _damage_pass == FULL_REPAINT ? span : in_damage (span));
+  }
+
+  void
+  SoftBackend::stroke (const SoftPath &path, const stroke_t &st, const Rasterizer::span_func_t &span)
+  {
+    _lines.clear ();
+    _closed.clear ();
+    path.flatten (_context_manager->get_current ()->matrix, _lines, _closed);
+    _raster.reset (_width, _height);
+    _raster.add_stroke (_lines, _closed, st);
+    _raster.render (false, _damage_pass == FULL_REPAINT ? span : in_damage (span));
+  }
+
+  /* the rectangles of a damage region never overlap, so no pixel is
+   * blended twice */
+  Rasterizer::span_func_t
+  SoftBackend::in_damage (const Rasterizer::span_func_t &span)
+  {
+    const DamageRegion &d = _damage_pass == PICKING_PASS ? _window->pick_damage () : _window->damage ();
+    if (d.all ())
+      return span;
+    const vector<DamageRegion::rect_t> *rects = &d.rects ();
+    return [rects, span] (int y, int x0, int x1, const float *cov) {
+      for (auto &r : *rects) {
+        if (y < r.y0 || y >= r.y1)
+          continue;
+        int a = std::max (x0, r.x0), b = std::min (x1, r.x1);
+        if (a < b)
+          span (y, a, b, cov);
+      }
+    };
+  }
+
+  /* the box covers the outline used for picking, whatever the style, and
+   * the pixels touched by the anti-aliasing */
+  bool
+  SoftBackend::must_paint (AbstractGShape *s, const SoftPath &path)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    _lines.clear ();
+    _closed.clear ();
+    path.flatten (cur_context->matrix, _lines, _closed);
+    double x0 = HUGE_VAL, y0 = HUGE_VAL, x1 = -HUGE_VAL, y1 = -HUGE_VAL;
+    for (auto &l : _lines)
+      for (auto &p : l) {
+        x0 = std::min (x0, p.x);
+        y0 = std::min (y0, p.y);
+        x1 = std::max (x1, p.x);
+        y1 = std::max (y1, p.y);
+      }
+    if (x0 > x1)
+      return AbstractBackend::must_paint (s, 0, 0, 0, 0);
+    stroke_t st = current_stroke (cur_context);
+    double pad = st.width / 2 * (st.join == JOIN_MITER ? std::max (st.miter_limit, 1.5) : 1.5) + 1;
+    return AbstractBackend::must_paint (s, x0 - pad, y0 - pad, x1 - x0 + 2 * pad, y1 - y0 + 2 * pad);
+  }
+
+  /* the widths are given in user units, but a null width draws a line of
+   * one pixel whatever the scale, as Qt does */
+  stroke_t
+  SoftBackend::current_stroke (SoftContext *ctx)
+  {
+    double scale = ctx->pen_width > 0 ? ctx->matrix.scale () : 1;
+    stroke_t st;
+    st.width = ctx->pen_width > 0 ? ctx->pen_width * scale : 1;
+    st.cap = ctx->cap;
+    st.join = ctx->join;
+    st.miter_limit = ctx->miter_limit;
+    for (double d : ctx->dashes)
+      st.dashes.push_back (d * scale);
+    st.dash_offset = ctx->dash_offset * scale;
+    return st;
+  }
+
+  void
+  SoftBackend::draw_shape (AbstractGShape *s, const SoftPath &path, double x, double y, double w, double h)
+  {
+    if (_pixels == nullptr)
+      return;
+    load_drawing_context (s);
+    if (!must_paint (s, path))
+      return;
+    SoftContext *cur_context = _context_manager->get_current ();
+    if (_damage_pass != PICKING_PASS) {
+      if (cur_context->fill_type != SOFT_NO_FILL) {
+        Rasterizer::span_func_t span = paint_span (cur_context, x, y, w, h);
+        if (span)
+          fill (path, cur_context->even_odd, span);
+      }
+      if (cur_context->pen_on)
+        stroke (path, current_stroke (cur_context), color_span (cur_context, cur_context->pen_color));
+    }
+
+    if (is_in_picking_view (s))
+      pick (s, path);
+  }
+
+  /* the shape is drawn with its fill and its outline, whatever its style,
+   * in a color of its own and without anti-aliasing */
+  void
+  SoftBackend::pick (AbstractGShape *s, const SoftPath &path)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    unsigned int color = _picking_view->color_for (s);
+    int w = std::min (_width, _picking_view->width ()), h = std::min (_height, _picking_view->height ());
+    shared_ptr<vector<uint8_t> > clip = cur_context->clip;
+    SoftPickingView *pv = _picking_view;
+    Rasterizer::span_func_t span = [pv, color, clip, w, h, this] (int y, int x0, int x1, const float *cov) {
+      if (y >= h)
+        return;
+      for (int x = x0; x < std::min (x1, w); x++)
+        if (clipped (cov[x], clip.get (), (size_t) y * _width + x) >= 0.5f)
+          pv->set_pixel (x, y, color);
+    };
+    fill (path, cur_context->even_odd, span);
+    stroke_t st = current_stroke (cur_context);
+    st.dashes.clear ();
+    stroke (path, st, span);
+  }
+
+  /* as with Qt, a clip replaces the previous one until the end of the
+   * current component */
+  void
+  SoftBackend::clip (AbstractGShape *s, const SoftPath &path)
+  {
+    if (_pixels == nullptr)
+      return;
+    load_drawing_context (s);
+    SoftContext *cur_context = _context_manager->get_current ();
+    if (geometric_picking (nullptr) != nullptr) {
+      cur_context->pick_clip = add_picking_path (nullptr, path);
+    }
+    if (_damage_pass == BOUNDS_PASS)
+      return;
+    shared_ptr<vector<uint8_t> > mask = make_shared<vector<uint8_t> > ((size_t) _width * _height, 0);
+    int width = _width;
+    fill (path, cur_context->even_odd, [mask, width] (int y, int x0, int x1, const float *cov) {
+      uint8_t *row = mask->data () + (size_t) y * width;
+      for (int x = x0; x < x1; x++)
+        row[x] = std::min (cov[x], 1.f) * 255 + 0.5f;
+    });
+    cur_context->clip = mask;
+    if (is_in_picking_view (s))
+      _picking_view->add_gobj (s);
+  }
+
+  int
+  SoftBackend::text_length (const string &text, int encoding)
+  {
+    if (encoding != djnUtf8)
+      return text.size ();
+    int n = 0;
+    for (unsigned char c : text)
+      if ((c & 0xc0) != 0x80)
+        n++;
+    return n;
+  }
+
+  void
+  SoftBackend::update_text_geometry (Text* text, FontFamily* ff, FontSize* fsz, FontStyle* fs, FontWeight *fw)
+  {
+    double size = 12;
+    if (fsz)
+      size = fsz->size ()->get_value ();
+    text->set_width (text_length (text->text ()->get_value (), djnUtf8) * text_advance (size));
+    text->set_height (text_height (size));
+  }
+} /* namespace djnn */
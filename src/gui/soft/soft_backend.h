@@ -0,0 +1,223 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "soft_context.h"
+#include "soft_picking_view.h"
+#include "../picking/geometric_picking.h"
+#include "soft_raster.h"
+#include "../abstract_backend.h"
+
+#include <mutex>
+
+namespace djnn
+{
+  using namespace std;
+
+  struct SoftGeometry;
+
+  /* Offscreen backend: draws with anti-aliasing into the RGBA framebuffer
+   * of a SoftWindow, without any windowing system or graphics library */
+  class SoftBackend : public AbstractBackend
+  {
+  public:
+    static SoftBackend* instance ();
+    virtual
+    ~SoftBackend ();
+    /* non-premultiplied RGBA, 4 bytes per pixel */
+    void
+    set_target (uint8_t *pixels, int width, int height);
+    /* a SoftPickingView or a GeometricPicking */
+    void
+    set_picking_view (Picking *p);
+    WinImpl*
+    create_window (Window *win, const std::string& title, double x, double y, double w, double h) override;
+
+    //shapes
+    void
+    draw_rect (Rectangle *s, double x, double y, double w, double h, double rx, double ry) override;
+    void
+    draw_circle (Circle *s, double cx, double cy, double r) override;
+    void
+    draw_ellipse (Ellipse *s, double cx, double cy, double rx, double ry) override;
+    void
+    draw_line (Line *s, double x1, double y1, double x2, double y2) override;
+    void
+    draw_text (Text *t) override;
+    void
+    draw_poly (Poly* p) override;
+    void
+    draw_poly_point (double x, double y) override;
+    void
+    draw_path (Path *p) override;
+    void
+    draw_path_move (double x, double y) override;
+    void
+    draw_path_line (double x, double y) override;
+    void
+    draw_path_quadratic (double x1, double y1, double x, double y) override;
+    void
+    draw_path_cubic (double x1, double y1, double x2, double y2, double x, double y) override;
+    void
+    draw_path_arc (double rx, double ry, double rotx, double fl, double swfl, double x, double y) override;
+    void
+    draw_path_closure () override;
+    void
+    draw_path_segment (double xc, double yc, double th0, double th1, double rx, double ry, double xAxisRotation);
+    void
+    draw_rect_clip (RectangleClip *r, double x, double y, double w, double h) override;
+    void
+    draw_path_clip (Path *p) override;
+    void
+    draw_image (Image *i) override;
+
+    //style
+    void
+    load_fill_color (int r, int g, int b) override;
+    void
+    load_outline_color (int r, int g, int b) override;
+    void
+    load_fill_rule (djnFillRuleType rule) override;
+    void
+    load_no_outline () override;
+    void
+    load_no_fill () override;
+    void
+    load_texture (const std::string &path) override;
+    void
+    load_outline_opacity (float alpha) override;
+    void
+    load_fill_opacity (float alpha) override;
+    void
+    load_outline_width (double w) override;
+    void
+    load_outline_cap_style (djnCapStyle cap) override;
+    void
+    load_outline_join_style (djnJoinStyle join) override;
+    void
+    load_outline_miter_limit (int limit) override;
+    void
+    load_dash_array (vector<double> dash) override;
+    void
+    load_no_dash_array () override;
+    void
+    load_dash_offset (double offset) override;
+    void
+    load_gradient_stop (int r, int g, int b, float a, float offset) override;
+    void
+    load_linear_gradient (LinearGradient *g) override;
+    void
+    load_radial_gradient (RadialGradient *g) override;
+    void
+    load_font_size (djnLengthUnit unit, double size) override;
+    void
+    load_font_weight (int weight) override;
+    void
+    load_font_style (djnFontSlope style) override;
+    void
+    load_font_family (const string &family) override;
+    void
+    load_text_anchor (djnAnchorType anchor) override;
+
+    //transformations
+    void
+    load_translation (Translation*, double tx, double ty) override;
+    void
+    load_gradient_translation (GradientTranslation*, double tx, double ty) override;
+    void
+    load_rotation (Rotation*, double a, double cx, double cy) override;
+    void
+    load_gradient_rotation (GradientRotation*, double a, double cx, double cy) override;
+    void
+    load_scaling (Scaling*, double sx, double sy, double cx, double cy) override;
+    void
+    load_gradient_scaling (GradientScaling*, double sx, double sy, double cx, double cy) override;
+    void
+    load_skew_x (SkewX*, double a) override;
+    void
+    load_gradient_skew_x (GradientSkewX*, double a) override;
+    void
+    load_skew_y (SkewY*, double a) override;
+    void
+    load_gradient_skew_y (GradientSkewY*, double a) override;
+    void
+    load_homography (AbstractHomography*, double m11, double m12, double m13, double m14, double m21, double m22, double m23, double m24,
+                     double m31, double m32, double m33, double m34, double m41, double m42, double m43, double m44)
+                         override;
+    void
+    load_gradient_homography (AbstractHomography*, double m11, double m12, double m13, double m21, double m22, double m23, double m31,
+                              double m32, double m33) override;
+    void
+    update_text_geometry (Text* text, FontFamily* ff, FontSize* fsz, FontStyle* fs, FontWeight *fw) override;
+
+    /* greeked text: every glyph is a box of the same advance */
+    static double
+    text_advance (double font_size) { return font_size * 0.6; }
+    static double
+    text_height (double font_size) { return font_size * 1.2; }
+    static int
+    text_length (const string &text, int encoding);
+
+  private:
+    static SoftBackend *_instance;
+    static std::once_flag onceFlag;
+    SoftBackend ();
+    void
+    load_drawing_context (AbstractGShape *s);
+    void
+    draw_shape (AbstractGShape *s, const SoftPath &path, double x, double y, double w, double h);
+    bool
+    must_paint (AbstractGShape *s, const SoftPath &path);
+    Rasterizer::span_func_t
+    in_damage (const Rasterizer::span_func_t &span);
+    void
+    fill (const SoftPath &path, bool even_odd, const Rasterizer::span_func_t &span);
+    void
+    stroke (const SoftPath &path, const stroke_t &st, const Rasterizer::span_func_t &span);
+    Rasterizer::span_func_t
+    paint_span (SoftContext *ctx, double x, double y, double w, double h);
+    Rasterizer::span_func_t
+    color_span (SoftContext *ctx, const soft_color_t &c);
+    void
+    blend (uint8_t *p, const soft_color_t &c, float coverage);
+    void
+    pick (AbstractGShape *s, const SoftPath &path);
+    void
+    clip (AbstractGShape *s, const SoftPath &path);
+    void
+    prepare_gradient (AbstractGradient *g);
+    stroke_t
+    current_stroke (SoftContext *ctx);
+    bool
+    is_in_picking_view (AbstractGShape *s);
+    GeometricPicking*
+    geometric_picking (AbstractGShape *s);
+    int
+    add_picking_path (AbstractGShape *s, const SoftPath &path);
+    SoftGeometry*
+    path_geometry (Path *p);
+    uint8_t *_pixels;
+    int _width, _height;
+    SoftPickingView *_picking_view;
+    GeometricPicking *_geometric_picking;
+    SoftContextManager *_context_manager;
+    Rasterizer _raster;
+    vector<polyline_t> _lines;
+    vector<bool> _closed;
+    SoftPath cur_path;
+    shared_ptr<SoftGradient> cur_gradient;
+  };
+
+} /* namespace djnn */
@@ -0,0 +1,445 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "../backend.h"
+
+#include "soft_context.h"
+#include "soft_backend.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace djnn
+{
+  void
+  SoftBackend::draw_rect (Rectangle *s, double x, double y, double w, double h, double rx, double ry)
+  {
+    SoftPath path;
+    path.add_rect (x, y, w, h, rx, ry);
+    GeometricPicking *g = geometric_picking (s);
+    if (g)
+      g->add_rect (s, x, y, w, h, rx, ry);
+    draw_shape (s, path, x, y, w, h);
+  }
+
+  void
+  SoftBackend::draw_circle (Circle *s, double cx, double cy, double r)
+  {
+    SoftPath path;
+    path.add_ellipse (cx, cy, r, r);
+    GeometricPicking *g = geometric_picking (s);
+    if (g)
+      g->add_ellipse (s, cx, cy, r, r);
+    draw_shape (s, path, cx - r, cy - r, 2 * r, 2 * r);
+  }
+
+  void
+  SoftBackend::draw_ellipse (Ellipse *s, double cx, double cy, double rx, double ry)
+  {
+    SoftPath path;
+    path.add_ellipse (cx, cy, rx, ry);
+    GeometricPicking *g = geometric_picking (s);
+    if (g)
+      g->add_ellipse (s, cx, cy, rx, ry);
+    draw_shape (s, path, cx - rx, cy - ry, 2 * rx, 2 * ry);
+  }
+
+  void
+  SoftBackend::draw_line (Line *s, double x1, double y1, double x2, double y2)
+  {
+    SoftPath path;
+    path.move_to (x1, y1);
+    path.line_to (x2, y2);
+    add_picking_path (s, path);
+    draw_shape (s, path, x1, y1, sqrt ((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1)), 1);
+  }
+
+  static double curTextX = 0.;
+  static double curTextY = 0.;
+  /* the glyphs last laid out for a Text, unless its string has changed */
+  struct SoftTextLayout : public GeometryCache
+  {
+    int encoding;
+    string text;
+    int length; // in characters
+    vector<int> glyphs; // positions, in advances, of the characters that are not spaces
+  };
+
+  void
+  SoftBackend::draw_text (Text *t)
+  {
+    if (_pixels == nullptr)
+      return;
+    double x = t->x ()->get_value ();
+    double y = t->y ()->get_value ();
+    double dx = t->dx ()->get_value ();
+    double dy = t->dy ()->get_value ();
+    int dxU = t->dxU ()->get_value ();
+    int dyU = t->dyU ()->get_value ();
+    int encoding = t->encoding ()->get_value ();
+    const std::string &text = t->text ()->get_value ();
+    SoftContext *cur_context = _context_manager->get_current ();
+    double dxfactor = cur_context->factor[dxU];
+    double dyfactor = cur_context->factor[dyU];
+
+    if (dxU == djnPercentLength) {
+      int v = (int) _window->width ()->get_value ();
+      dx = v * dx / 100;
+    }
+    if (dyU == djnPercentLength) {
+      int v = _window->height ()->get_value ();
+      dy = v * dy / 100;
+    }
+
+    if (x == -1) {
+      x = curTextX;
+    }
+    if (y == -1) {
+      y = curTextY;
+    }
+    double posX = x + (dx * dxfactor);
+    double posY = y + (dy * dyfactor);
+
+    load_drawing_context (t);
+
+    SoftTextLayout *layout = static_cast<SoftTextLayout*> (t->cache ());
+    if (layout == nullptr || layout->encoding != encoding || layout->text != text) {
+      if (layout == nullptr) {
+        layout = new SoftTextLayout;
+        t->set_cache (layout);
+      }
+      layout->encoding = encoding;
+      layout->text = text;
+      layout->glyphs.clear ();
+      int n = 0;
+      for (unsigned char c : text) {
+        if (encoding == djnUtf8 && (c & 0xc0) == 0x80)
+          continue;
+        if (!isspace (c))
+          layout->glyphs.push_back (n);
+        n++;
+      }
+      layout->length = n;
+    }
+    double size = cur_context->font_size;
+    double advance = text_advance (size);
+    double width = layout->length * advance;
+    double height = text_height (size);
+
+    /* applying alignment attribute */
+    switch (cur_context->text_anchor)
+      {
+      case djnMiddleAnchor:
+        posX = posX - (width / 2.0);
+        break;
+      case djnEndAnchor:
+        posX = posX - width;
+        break;
+      }
+
+    curTextX = posX + width;
+    curTextY = posY;
+
+    SoftPath rect;
+    rect.add_rect (posX, posY - height, width, height);
+    GeometricPicking *g = geometric_picking (t);
+    if (g)
+      g->add_rect (t, posX, posY - height, width, height);
+    if (!must_paint (t, rect))
+      return;
+
+    /* text is drawn with the fill color, and not drawn with a gradient, as
+     * with Qt; each glyph is a box resting on the baseline */
+    if (cur_context->fill_type == SOFT_SOLID_FILL && _damage_pass != PICKING_PASS) {
+      SoftPath glyphs;
+      for (int g : layout->glyphs)
+        glyphs.add_rect (posX + g * advance + advance * 0.1, posY - size * 0.7, advance * 0.8, size * 0.7);
+      fill (glyphs, false, color_span (cur_context, cur_context->fill_color));
+    }
+
+    if (is_in_picking_view (t))
+      pick (t, rect);
+  }
+
+  /* the path of a Poly or a Path and its bounding box, built again only
+   * when one of its points has changed */
+  struct SoftGeometry : public GeometryCache
+  {
+    SoftPath path;
+    double x, y, w, h;
+  };
+
+  template <typename T> static SoftGeometry*
+  new_geometry (T *shape, const SoftPath &path)
+  {
+    SoftGeometry *g = new SoftGeometry;
+    g->path = path;
+    path.bounding_box (g->x, g->y, g->w, g->h);
+    shape->set_bounding_box (g->x, g->y, g->w, g->h);
+    return g;
+  }
+
+  SoftGeometry*
+  SoftBackend::path_geometry (Path *p)
+  {
+    if (p->invalid_cache ()) {
+      cur_path.clear ();
+      p->items ()->draw ();
+      p->set_cache (new_geometry (p, cur_path));
+    }
+    return static_cast<SoftGeometry*> (p->cache ());
+  }
+
+  void
+  SoftBackend::draw_poly (Poly* p)
+  {
+    if (p->invalid_cache ()) {
+      cur_path.clear ();
+      p->points ()->draw ();
+      if (p->closed ())
+        cur_path.close ();
+      p->set_cache (new_geometry (p, cur_path));
+    }
+    SoftGeometry *g = static_cast<SoftGeometry*> (p->cache ());
+    add_picking_path (p, g->path);
+    draw_shape (p, g->path, g->x, g->y, g->w, g->h);
+  }
+
+  void
+  SoftBackend::draw_poly_point (double x, double y)
+  {
+    if (cur_path.empty ())
+      cur_path.move_to (x, y);
+    else
+      cur_path.line_to (x, y);
+  }
+
+  void
+  SoftBackend::draw_path (Path *p)
+  {
+    SoftGeometry *g = path_geometry (p);
+    add_picking_path (p, g->path);
+    draw_shape (p, g->path, g->x, g->y, g->w, g->h);
+  }
+
+  void
+  SoftBackend::draw_path_move (double x, double y)
+  {
+    cur_path.move_to (x, y);
+  }
+
+  void
+  SoftBackend::draw_path_line (double x, double y)
+  {
+    cur_path.line_to (x, y);
+  }
+
+  void
+  SoftBackend::draw_path_quadratic (double x1, double y1, double x, double y)
+  {
+    cur_path.quad_to (x1, y1, x, y);
+  }
+
+  void
+  SoftBackend::draw_path_cubic (double x1, double y1, double x2, double y2, double x, double y)
+  {
+    cur_path.cubic_to (x1, y1, x2, y2, x, y);
+  }
+
+  /*
+   * the arc handling code underneath is from XSVG,
+   * reused under the terms reproduced in xsvg.license.terms
+   */
+#define PI 3.14159265359
+  void
+  SoftBackend::draw_path_arc (double rx, double ry, double x_axis_rotation, double large_arc_flag, double sweep_flag,
+                              double x, double y)
+  {
+    double curx = cur_path.current_point ().x;
+    double cury = cur_path.current_point ().y;
+    double sin_th, cos_th;
+    double a00, a01, a10, a11;
+    double x0, y0, x1, y1, xc, yc;
+    double d, sfactor, sfactor_sq;
+    double th0, th1, th_arc;
+    int i, n_segs;
+    double dx, dy, dx1, dy1, Pr1, Pr2, Px, Py, check;
+    rx = fabs (rx);
+    ry = fabs (ry);
+    /* Spec : a null radius gives a straight line */
+    if (rx == 0 || ry == 0) {
+      cur_path.line_to (x, y);
+      return;
+    }
+
+    sin_th = sin (x_axis_rotation * (PI / 180.0));
+    cos_th = cos (x_axis_rotation * (PI / 180.0));
+
+    dx = (curx - x) / 2.0;
+    dy = (cury - y) / 2.0;
+    dx1 = cos_th * dx + sin_th * dy;
+    dy1 = -sin_th * dx + cos_th * dy;
+    Pr1 = rx * rx;
+    Pr2 = ry * ry;
+    Px = dx1 * dx1;
+    Py = dy1 * dy1;
+    /* Spec : check if radii are large enough */
+    check = Px / Pr1 + Py / Pr2;
+    if (check > 1) {
+      rx = rx * sqrt (check);
+      ry = ry * sqrt (check);
+    }
+
+    a00 = cos_th / rx;
+    a01 = sin_th / rx;
+    a10 = -sin_th / ry;
+    a11 = cos_th / ry;
+    x0 = a00 * curx + a01 * cury;
+    y0 = a10 * curx + a11 * cury;
+    x1 = a00 * x + a01 * y;
+    y1 = a10 * x + a11 * y;
+    /* (x0, y0) is current point in transformed coordinate space.
+     (x1, y1) is new point in transformed coordinate space.
+     The arc fits a unit-radius circle in this space.
+     */
+    d = (x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0);
+    sfactor_sq = 1.0 / d - 0.25;
+    if (sfactor_sq < 0)
+      sfactor_sq = 0;
+    sfactor = sqrt (sfactor_sq);
+    if (sweep_flag == large_arc_flag)
+      sfactor = -sfactor;
+    xc = 0.5 * (x0 + x1) - sfactor * (y1 - y0);
+    yc = 0.5 * (y0 + y1) + sfactor * (x1 - x0);
+    /* (xc, yc) is center of the circle. */
+
+    th0 = atan2 (y0 - yc, x0 - xc);
+    th1 = atan2 (y1 - yc, x1 - xc);
+
+    th_arc = th1 - th0;
+    if (th_arc < 0 && sweep_flag)
+      th_arc += 2 * PI;
+    else if (th_arc > 0 && !sweep_flag)
+      th_arc -= 2 * PI;
+
+    n_segs = ceil (fabs (th_arc / (PI * 0.5 + 0.001)));
+
+    for (i = 0; i < n_segs; i++) {
+      draw_path_segment (xc, yc, th0 + i * th_arc / n_segs, th0 + (i + 1) * th_arc / n_segs, rx, ry, x_axis_rotation);
+    }
+  }
+
+  void
+  SoftBackend::draw_path_segment (double xc, double yc, double th0, double th1, double rx, double ry,
+                                  double xAxisRotation)
+  {
+    double sinTh, cosTh;
+    double a00, a01, a10, a11;
+    double x1, y1, x2, y2, x3, y3;
+    double t;
+    double thHalf;
+
+    sinTh = sin (xAxisRotation * (PI / 180.0));
+    cosTh = cos (xAxisRotation * (PI / 180.0));
+
+    a00 = cosTh * rx;
+    a01 = -sinTh * ry;
+    a10 = sinTh * rx;
+    a11 = cosTh * ry;
+
+    thHalf = 0.5 * (th1 - th0);
+    t = (8.0 / 3.0) * sin (thHalf * 0.5) * sin (thHalf * 0.5) / sin (thHalf);
+    x1 = xc + cos (th0) - t * sin (th0);
+    y1 = yc + sin (th0) + t * cos (th0);
+    x3 = xc + cos (th1);
+    y3 = yc + sin (th1);
+    x2 = x3 + t * sin (th1);
+    y2 = y3 - t * cos (th1);
+
+    cur_path.cubic_to (a00 * x1 + a01 * y1, a10 * x1 + a11 * y1, a00 * x2 + a01 * y2, a10 * x2 + a11 * y2,
+                       a00 * x3 + a01 * y3, a10 * x3 + a11 * y3);
+  }
+
+  void
+  SoftBackend::draw_path_closure ()
+  {
+    cur_path.close ();
+  }
+
+  void
+  SoftBackend::draw_rect_clip (RectangleClip *s, double x, double y, double w, double h)
+  {
+    SoftPath path;
+    path.add_rect (x, y, w, h);
+    clip (s, path);
+  }
+
+  void
+  SoftBackend::draw_path_clip (Path *p)
+  {
+    clip (p, path_geometry (p)->path);
+  }
+
+  void
+  SoftBackend::draw_image (Image *i)
+  {
+    if (_pixels == nullptr)
+      return;
+    double x = i->x ()->get_value ();
+    double y = i->y ()->get_value ();
+    double w = i->width ()->get_value ();
+    double h = i->height ()->get_value ();
+    load_drawing_context (i);
+    if (w <= 0 || h <= 0)
+      return;
+
+    /* pickable by its rectangle even while the file is being decoded */
+    SoftPath rect;
+    rect.add_rect (x, y, w, h);
+    GeometricPicking *g = geometric_picking (i);
+    if (g)
+      g->add_rect (i, x, y, w, h);
+    if (!must_paint (i, rect))
+      return;
+    if (is_in_picking_view (i))
+      pick (i, rect);
+    if (_damage_pass == PICKING_PASS)
+      return;
+    shared_ptr<ImageData> data = ImageCache::instance ().get (i, 0, 0);
+    if (data == nullptr)
+      return;
+    const SoftImage *img = static_cast<SoftImageData*> (data.get ())->image.get ();
+    SoftContext *cur_context = _context_manager->get_current ();
+    affine_t to_user = cur_context->matrix.inverted ();
+    shared_ptr<vector<uint8_t> > clip = cur_context->clip;
+    /* nearest pixel, stretched to the rectangle */
+    fill (rect, false, [this, img, to_user, clip, x, y, w, h] (int py, int x0, int x1, const float *cov) {
+      uint8_t *row = _pixels + (size_t) py * _width * 4;
+      for (int px = x0; px < x1; px++) {
+        float a = std::min (cov[px], 1.f);
+        if (clip)
+          a *= (*clip)[(size_t) py * _width + px] * (1.f / 255);
+        if (a <= 0)
+          continue;
+        double ux, uy;
+        to_user.apply (px + 0.5, py + 0.5, ux, uy);
+        int ix = std::max (0, std::min (img->width - 1, (int) ((ux - x) / w * img->width)));
+        int iy = std::max (0, std::min (img->height - 1, (int) ((uy - y) / h * img->height)));
+        const uint8_t *t = &img->rgba[((size_t) iy * img->width + ix) * 4];
+        blend (row + px * 4, { (float) t[0], (float) t[1], (float) t[2], t[3] / 255.f }, a);
+      }
+    });
+  }
+} /* namespace djnn */
@@ -0,0 +1,243 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "../backend.h"
+
+#include "soft_backend.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+namespace djnn
+{
+  static int capStyleArray[3] =
+    { CAP_BUTT, CAP_ROUND, CAP_SQUARE };
+
+  static int joinStyleArray[3] =
+    { JOIN_MITER, JOIN_ROUND, JOIN_BEVEL };
+
+  void
+  SoftBackend::load_fill_color (int r, int g, int b)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    /* the opacity is kept, as with a Qt brush */
+    float a = cur_context->fill_type == SOFT_SOLID_FILL ? cur_context->fill_color.a : 1;
+    cur_context->fill_type = SOFT_SOLID_FILL;
+    cur_context->fill_color = { (float) r, (float) g, (float) b, a };
+  }
+
+  void
+  SoftBackend::load_outline_color (int r, int g, int b)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->pen_on = true;
+    cur_context->pen_color = { (float) r, (float) g, (float) b, cur_context->pen_color.a };
+  }
+
+  void
+  SoftBackend::load_fill_rule (djnFillRuleType rule)
+  {
+    _context_manager->get_current ()->even_odd = rule == djnEvenOddFill;
+  }
+
+  void
+  SoftBackend::load_no_outline ()
+  {
+    _context_manager->get_current ()->pen_on = false;
+  }
+
+  void
+  SoftBackend::load_no_fill ()
+  {
+    _context_manager->get_current ()->fill_type = SOFT_NO_FILL;
+  }
+
+  void
+  SoftBackend::load_texture (const std::string &path)
+  {
+    SoftImage *img = load_pnm (path);
+    if (img == nullptr) {
+      std::cerr << "Unable to load texture " << path << ", only binary PNM files are supported\n";
+      return;
+    }
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->fill_type = SOFT_TEXTURE_FILL;
+    cur_context->fill_color.a = 1;
+    cur_context->texture = shared_ptr<SoftImage> (img);
+  }
+
+  void
+  SoftBackend::load_outline_opacity (float a)
+  {
+    _context_manager->get_current ()->pen_color.a *= a;
+  }
+
+  void
+  SoftBackend::load_fill_opacity (float a)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->alpha *= a;
+    if (cur_context->fill_type == SOFT_SOLID_FILL || cur_context->fill_type == SOFT_TEXTURE_FILL)
+      cur_context->fill_color.a *= a;
+    else if (cur_context->fill_type == SOFT_LINEAR_FILL || cur_context->fill_type == SOFT_RADIAL_FILL) {
+      /* the gradient may be shared with the parent context */
+      cur_context->gradient = make_shared<SoftGradient> (*cur_context->gradient);
+      cur_context->gradient->scale_alpha (a);
+    }
+  }
+
+  void
+  SoftBackend::load_outline_width (double w)
+  {
+    _context_manager->get_current ()->pen_width = w;
+  }
+
+  void
+  SoftBackend::load_outline_cap_style (djnCapStyle cap)
+  {
+    int c = cap;
+    if (cap >= (sizeof(capStyleArray) / sizeof(int))) {
+      std::cerr << "Invalid cap style, default will be used\n";
+      c = 0;
+    }
+    _context_manager->get_current ()->cap = capStyleArray[c];
+  }
+
+  void
+  SoftBackend::load_outline_join_style (djnJoinStyle join)
+  {
+    int j = join;
+    if (join >= (sizeof(joinStyleArray) / sizeof(int))) {
+      std::cerr << "Invalid join style, default will be used\n";
+      j = 0;
+    }
+    _context_manager->get_current ()->join = joinStyleArray[j];
+  }
+
+  void
+  SoftBackend::load_outline_miter_limit (int limit)
+  {
+    _context_manager->get_current ()->miter_limit = limit;
+  }
+
+  void
+  SoftBackend::load_dash_array (vector<double> dash)
+  {
+    _context_manager->get_current ()->dashes = dash;
+  }
+
+  void
+  SoftBackend::load_no_dash_array ()
+  {
+    _context_manager->get_current ()->dashes.clear ();
+  }
+
+  void
+  SoftBackend::load_dash_offset (double offset)
+  {
+    _context_manager->get_current ()->dash_offset = offset;
+  }
+
+  void
+  SoftBackend::load_gradient_stop (int r, int g, int b, float a, float offset)
+  {
+    cur_gradient->add_stop (offset, { (float) r, (float) g, (float) b, a });
+  }
+
+  void
+  SoftBackend::prepare_gradient (AbstractGradient *g)
+  {
+    cur_gradient->bounding_box_units = g->coords ()->get_value () == djnLocalCoords;
+    cur_gradient->spread = g->spread ()->get_value ();
+    /* drawn in contexts of their own, hence the stops and the transforms
+     * are kept by the gradient */
+    g->stops ()->draw ();
+    g->transforms ()->draw ();
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->fill_type = cur_gradient->linear ? SOFT_LINEAR_FILL : SOFT_RADIAL_FILL;
+    cur_context->gradient = cur_gradient;
+  }
+
+  void
+  SoftBackend::load_linear_gradient (LinearGradient *g)
+  {
+    cur_gradient = make_shared<SoftGradient> ();
+    cur_gradient->linear = true;
+    cur_gradient->x1 = g->x1 ()->get_value ();
+    cur_gradient->y1 = g->y1 ()->get_value ();
+    cur_gradient->x2 = g->x2 ()->get_value ();
+    cur_gradient->y2 = g->y2 ()->get_value ();
+    prepare_gradient (g);
+  }
+
+  void
+  SoftBackend::load_radial_gradient (RadialGradient *g)
+  {
+    cur_gradient = make_shared<SoftGradient> ();
+    cur_gradient->linear = false;
+    cur_gradient->cx = g->cx ()->get_value ();
+    cur_gradient->cy = g->cy ()->get_value ();
+    cur_gradient->r = g->r ()->get_value ();
+    cur_gradient->fx = g->fx ()->get_value ();
+    cur_gradient->fy = g->fy ()->get_value ();
+    prepare_gradient (g);
+  }
+
+  void
+  SoftBackend::load_font_size (djnLengthUnit unit, double size)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    if (unit == djnPxLength)
+      cur_context->font_size = size;
+    else
+      cur_context->font_size = size * cur_context->get_unit_factor (unit);
+    cur_context->update_relative_units ();
+  }
+
+  void
+  SoftBackend::load_font_weight (int weight)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    if (weight == -1)
+      weight = cur_context->font_weight - 10 < 0 ? 0 : cur_context->font_weight - 10; /* lighter */
+    if (weight == 100)
+      weight = cur_context->font_weight + 10 > 99 ? 99 : cur_context->font_weight + 10; /* bolder */
+    cur_context->font_weight = weight;
+  }
+
+  void
+  SoftBackend::load_font_style (djnFontSlope style)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    int val = style;
+    if (style > djnObliqueFont) {
+      std::cerr << "Invalid font style, default will be used\n";
+      val = 0;
+    }
+    cur_context->font_style = val;
+  }
+
+  void
+  SoftBackend::load_font_family (const string &family)
+  {
+    _context_manager->get_current ()->font_family = family;
+  }
+
+  void
+  SoftBackend::load_text_anchor (djnAnchorType anchor)
+  {
+    _context_manager->get_current ()->text_anchor = anchor;
+  }
+} /* namespace djnn */
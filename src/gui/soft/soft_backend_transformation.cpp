@@ -0,0 +1,127 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "../backend.h"
+
+#include "soft_context.h"
+#include "soft_backend.h"
+
+#include <cmath>
+
+namespace djnn
+{
+  /* with the same conventions as the Qt backend: the shape transforms are
+   * applied before the current matrix, and the 3D parts of the homographies
+   * are dropped */
+  static affine_t
+  rotation (double a)
+  {
+    double a_rad = a * 0.017453292519943; /* convert degrees to radians */
+    return affine_t (cos (a_rad), sin (a_rad), -sin (a_rad), cos (a_rad), 0, 0);
+  }
+
+  static affine_t
+  around (const affine_t &m, double cx, double cy)
+  {
+    if (!cx && !cy)
+      return m;
+    return affine_t (1, 0, 0, 1, cx, cy) * m * affine_t (1, 0, 0, 1, -cx, -cy);
+  }
+
+  void
+  SoftBackend::load_translation (Translation*, double tx, double ty)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->matrix = cur_context->matrix * affine_t (1, 0, 0, 1, tx, ty);
+  }
+
+  void
+  SoftBackend::load_gradient_translation (GradientTranslation*, double tx, double ty)
+  {
+    cur_gradient->transform = cur_gradient->transform * affine_t (1, 0, 0, 1, tx, ty);
+  }
+
+  void
+  SoftBackend::load_rotation (Rotation*, double a, double cx, double cy)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->matrix = cur_context->matrix * around (rotation (a), cx, cy);
+  }
+
+  void
+  SoftBackend::load_gradient_rotation (GradientRotation*, double a, double cx, double cy)
+  {
+    cur_gradient->transform = cur_gradient->transform * around (rotation (a), cx, cy);
+  }
+
+  void
+  SoftBackend::load_scaling (Scaling*, double sx, double sy, double cx, double cy)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->matrix = cur_context->matrix * around (affine_t (sx, 0, 0, sy, 0, 0), cx, cy);
+  }
+
+  void
+  SoftBackend::load_gradient_scaling (GradientScaling*, double sx, double sy, double cx, double cy)
+  {
+    cur_gradient->transform = cur_gradient->transform * around (affine_t (sx, 0, 0, sy, 0, 0), cx, cy);
+  }
+
+  void
+  SoftBackend::load_skew_x (SkewX*, double a)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    double a_rad = a * 0.017453292519943; /* convert degrees to radians */
+    cur_context->matrix = cur_context->matrix * affine_t (1, 0, tan (a_rad), 1, 0, 0);
+  }
+
+  void
+  SoftBackend::load_skew_y (SkewY*, double a)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    double a_rad = a * 0.017453292519943; /* convert degrees to radians */
+    cur_context->matrix = cur_context->matrix * affine_t (1, tan (a_rad), 0, 1, 0, 0);
+  }
+
+  void
+  SoftBackend::load_gradient_skew_x (GradientSkewX*, double a)
+  {
+    double a_rad = a * 0.017453292519943; /* convert degrees to radians */
+    cur_gradient->transform = cur_gradient->transform * affine_t (1, 0, tan (a_rad), 1, 0, 0);
+  }
+
+  void
+  SoftBackend::load_gradient_skew_y (GradientSkewY*, double a)
+  {
+    double a_rad = a * 0.017453292519943; /* convert degrees to radians */
+    cur_gradient->transform = cur_gradient->transform * affine_t (1, tan (a_rad), 0, 1, 0, 0);
+  }
+
+  void
+  SoftBackend::load_homography (AbstractHomography*, double m11, double m12, double m13, double m14, double m21, double m22, double m23,
+                                double m24, double m31, double m32, double m33, double m34, double m41, double m42,
+                                double m43, double m44)
+  {
+    SoftContext *cur_context = _context_manager->get_current ();
+    cur_context->matrix = cur_context->matrix * affine_t (m11, m21, m12, m22, m14, m24);
+  }
+
+  /* the Qt backend composes the gradient homography after the current transform */
+  void
+  SoftBackend::load_gradient_homography (AbstractHomography*, double m11, double m12, double m13, double m21, double m22, double m23,
+                                         double m31, double m32, double m33)
+  {
+    cur_gradient->transform = affine_t (m11, m12, m21, m22, m31, m32) * cur_gradient->transform;
+  }
+} /* namespace djnn */
@@ -0,0 +1,157 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "soft_context.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace djnn
+{
+  static const int lut_size = 256;
+
+  SoftGradient::SoftGradient () :
+      linear (true), x1 (0), y1 (0), x2 (0), y2 (0), cx (0), cy (0), r (0), fx (0), fy (0), spread (djnPadFill),
+      bounding_box_units (false)
+  {
+  }
+
+  /* as with Qt, a stop at an existing offset replaces it */
+  void
+  SoftGradient::add_stop (float offset, const soft_color_t &c)
+  {
+    offset = std::max (0.f, std::min (1.f, offset));
+    auto it = std::lower_bound (_stops.begin (), _stops.end (), offset,
+                                [] (const pair<float, soft_color_t> &s, float o) { return s.first < o; });
+    if (it != _stops.end () && it->first == offset)
+      it->second = c;
+    else
+      _stops.insert (it, pair<float, soft_color_t> (offset, c));
+    _lut.clear ();
+  }
+
+  void
+  SoftGradient::scale_alpha (float a)
+  {
+    for (auto &s : _stops)
+      s.second.a *= a;
+    _lut.clear ();
+  }
+
+  void
+  SoftGradient::build_lut ()
+  {
+    if (_stops.empty ()) {
+      /* Qt default: from black to white */
+      add_stop (0, { 0, 0, 0, 1 });
+      add_stop (1, { 255, 255, 255, 1 });
+    }
+    _lut.resize (lut_size);
+    size_t j = 0;
+    for (int i = 0; i < lut_size; i++) {
+      float t = (float) i / (lut_size - 1);
+      while (j < _stops.size () && _stops[j].first < t)
+        j++;
+      if (j == 0)
+        _lut[i] = _stops.front ().second;
+      else if (j == _stops.size ())
+        _lut[i] = _stops.back ().second;
+      else {
+        const pair<float, soft_color_t> &s0 = _stops[j - 1], &s1 = _stops[j];
+        float u = (t - s0.first) / (s1.first - s0.first);
+        _lut[i] = { s0.second.r + (s1.second.r - s0.second.r) * u, s0.second.g + (s1.second.g - s0.second.g) * u,
+                    s0.second.b + (s1.second.b - s0.second.b) * u, s0.second.a + (s1.second.a - s0.second.a) * u };
+      }
+    }
+  }
+
+  const soft_color_t&
+  SoftGradient::color_at (double t)
+  {
+    if (_lut.empty ())
+      build_lut ();
+    switch (spread)
+      {
+      case djnRepeatFill:
+        t = t - floor (t);
+        break;
+      case djnReflectFill:
+        t = fmod (fabs (t), 2);
+        if (t > 1)
+          t = 2 - t;
+        break;
+      default:
+        t = std::max (0., std::min (1., t));
+      }
+    return _lut[(int) (t * (lut_size - 1) + 0.5)];
+  }
+
+  SoftContext::SoftContext () :
+      fill_type (SOFT_SOLID_FILL), fill_color ( { 211, 211, 211, 1 }), /* lightgray */
+      alpha (1), even_odd (true), pen_on (true), pen_color ( { 47, 79, 79, 1 }), /* darkslategray */
+      pen_width (0), cap (CAP_ROUND), join (JOIN_ROUND), miter_limit (2), dash_offset (0), font_size (12),
+      font_weight (50), font_style (djnNormalFont), text_anchor (djnStartAnchor), pick_clip (-1)
+  {
+    int DEFAULT_DPI_RES = 96;
+    for (int i = 0; i < 10; i++)
+      factor[i] = 1.;
+    factor[djnInLength] = DEFAULT_DPI_RES; /* pixels by inch */
+    factor[djnCmLength] = DEFAULT_DPI_RES * 2.54; /* pixels by cm */
+    factor[djnMmLength] = DEFAULT_DPI_RES * 25.4; /* pixels by mm */
+    factor[djnPtLength] = DEFAULT_DPI_RES / 72; /* pixels by point (given that 1pt = 1/72 inch) */
+    factor[djnPcLength] = (DEFAULT_DPI_RES / 72) * 12; /* pixels by pica (given that 1pc = 12pt) */
+    update_relative_units ();
+  }
+
+  void
+  SoftContext::update_relative_units ()
+  {
+    factor[djnEmLength] = font_size;
+    factor[djnExLength] = font_size / 2.; /* rough approximation */
+  }
+
+  SoftContext*
+  SoftContextManager::get_current ()
+  {
+    if (_depth == 0)
+      return &_default;
+    return &_context_list[_depth - 1];
+  }
+
+  void
+  SoftContextManager::push ()
+  {
+    if (_depth == _context_list.size ())
+      _context_list.emplace_back ();
+    if (_depth == 0)
+      _context_list[0] = SoftContext ();
+    else
+      _context_list[_depth] = _context_list[_depth - 1];
+    _depth++;
+  }
+
+  void
+  SoftContextManager::reset_base ()
+  {
+    _default = SoftContext ();
+  }
+
+  void
+  SoftContextManager::pop ()
+  {
+    if (_depth > 0)
+      _depth--;
+  }
+
+} /* namespace djnn */
@@ -0,0 +1,118 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "soft_raster.h"
+#include "soft_image.h"
+#include "../style/style_types.h"
+#include "../../core/execution/component_observer.h"
+
+#include <memory>
+#include <string>
+
+namespace djnn
+{
+  enum { SOFT_NO_FILL, SOFT_SOLID_FILL, SOFT_LINEAR_FILL, SOFT_RADIAL_FILL, SOFT_TEXTURE_FILL };
+
+  struct soft_color_t
+  {
+    float r, g, b, a; // 0..255 for the components, 0..1 for alpha
+  };
+
+  class SoftGradient
+  {
+  public:
+    SoftGradient ();
+    void add_stop (float offset, const soft_color_t &c);
+    void scale_alpha (float a);
+    /* color at t, after the spread method */
+    const soft_color_t& color_at (double t);
+
+    bool linear;
+    double x1, y1, x2, y2; // linear
+    double cx, cy, r, fx, fy; // radial
+    int spread;
+    bool bounding_box_units;
+    affine_t transform;
+
+  private:
+    void build_lut ();
+    vector<pair<float, soft_color_t> > _stops;
+    vector<soft_color_t> _lut;
+  };
+
+  class SoftContext
+  {
+    friend class SoftBackend;
+  public:
+    SoftContext ();
+    void update_relative_units ();
+    double get_unit_factor (djnLengthUnit unit) { return factor[unit]; }
+
+  private:
+    int fill_type;
+    soft_color_t fill_color;
+    shared_ptr<SoftGradient> gradient;
+    shared_ptr<SoftImage> texture;
+    double alpha;
+    bool even_odd;
+    bool pen_on;
+    soft_color_t pen_color;
+    double pen_width; // 0 for a one pixel wide line whatever the transform
+    int cap, join;
+    double miter_limit;
+    vector<double> dashes;
+    double dash_offset;
+    affine_t matrix;
+    double font_size; // pixels
+    int font_weight, font_style;
+    string font_family;
+    int text_anchor;
+    double factor[10];
+    /* coverage of the window pixels, shared until modified */
+    shared_ptr<vector<uint8_t> > clip;
+    /* the same clip, recorded in a GeometricPicking */
+    int pick_clip;
+  };
+
+  /* contexts are kept by value and reused from one frame to the next, the
+   * stack only grows to the deepest nesting met */
+  class SoftContextManager : public ContextManager
+  {
+  public:
+    SoftContextManager () :
+        ContextManager (), _depth (0)
+    {
+      ComponentObserver::instance ().add_draw_context_manager (this);
+    }
+    virtual
+    ~SoftContextManager ()
+    {
+      ComponentObserver::instance ().remove_draw_context_manager (this);
+    }
+    void pop () override;
+    void push () override;
+    SoftContext* get_current ();
+    /* the context of the shapes drawn outside of any component is started
+     * again with each frame */
+    void reset_base ();
+
+  private:
+    vector<SoftContext> _context_list;
+    size_t _depth;
+    SoftContext _default; // for the shapes drawn outside of any component
+  };
+
+} /* namespace djnn */
@@ -0,0 +1,171 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "soft_image.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+namespace djnn
+{
+  static int
+  read_pnm_int (FILE *f)
+  {
+    int c = fgetc (f);
+    while (c != EOF && (isspace (c) || c == '#')) {
+      if (c == '#')
+        while (c != EOF && c != '\n')
+          c = fgetc (f);
+      c = fgetc (f);
+    }
+    int v = -1;
+    while (c != EOF && isdigit (c)) {
+      v = (v < 0 ? 0 : v * 10) + c - '0';
+      c = fgetc (f);
+    }
+    return v;
+  }
+
+  SoftImage*
+  load_pnm (const string &path)
+  {
+    FILE *f = fopen (path.c_str (), "rb");
+    if (f == nullptr)
+      return nullptr;
+    char magic[2];
+    if (fread (magic, 1, 2, f) != 2 || magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6')) {
+      fclose (f);
+      return nullptr;
+    }
+    int channels = magic[1] == '6' ? 3 : 1;
+    /* the single whitespace after maxval is consumed by read_pnm_int */
+    int w = read_pnm_int (f), h = read_pnm_int (f), maxval = read_pnm_int (f);
+    if (w <= 0 || h <= 0 || maxval <= 0 || maxval > 65535) {
+      fclose (f);
+      return nullptr;
+    }
+    int sample = maxval > 255 ? 2 : 1;
+    vector<uint8_t> raw ((size_t) w * h * channels * sample);
+    if (fread (raw.data (), 1, raw.size (), f) != raw.size ()) {
+      fclose (f);
+      return nullptr;
+    }
+    fclose (f);
+    SoftImage *img = new SoftImage;
+    img->width = w;
+    img->height = h;
+    img->rgba.resize ((size_t) w * h * 4);
+    for (size_t i = 0; i < (size_t) w * h; i++) {
+      for (int k = 0; k < 3; k++) {
+        size_t j = (i * channels + (channels == 3 ? k : 0)) * sample;
+        /* most significant byte first for 16-bit samples */
+        unsigned v = sample == 1 ? raw[j] : (raw[j] << 8) | raw[j + 1];
+        img->rgba[i * 4 + k] = std::min (v, (unsigned) maxval) * 255 / maxval;
+      }
+      img->rgba[i * 4 + 3] = 255;
+    }
+    return img;
+  }
+
+  static uint32_t crc_table[256];
+
+  static uint32_t
+  crc (uint32_t c, const uint8_t *buf, size_t len)
+  {
+    if (crc_table[1] == 0)
+      for (uint32_t n = 0; n < 256; n++) {
+        uint32_t v = n;
+        for (int k = 0; k < 8; k++)
+          v = v & 1 ? 0xedb88320u ^ (v >> 1) : v >> 1;
+        crc_table[n] = v;
+      }
+    c = ~c;
+    for (size_t i = 0; i < len; i++)
+      c = crc_table[(c ^ buf[i]) & 0xff] ^ (c >> 8);
+    return ~c;
+  }
+
+  static void
+  put32 (vector<uint8_t> &out, uint32_t v)
+  {
+    out.push_back (v >> 24);
+    out.push_back (v >> 16);
+    out.push_back (v >> 8);
+    out.push_back (v);
+  }
+
+  static void
+  write_chunk (FILE *f, const char *type, const vector<uint8_t> &data)
+  {
+    vector<uint8_t> buf;
+    put32 (buf, data.size ());
+    buf.insert (buf.end (), type, type + 4);
+    buf.insert (buf.end (), data.begin (), data.end ());
+    put32 (buf, crc (0, buf.data () + 4, buf.size () - 4));
+    fwrite (buf.data (), 1, buf.size (), f);
+  }
+
+  bool
+  write_png (const string &path, int width, int height, const uint8_t *rgba)
+  {
+    FILE *f = fopen (path.c_str (), "wb");
+    if (f == nullptr)
+      return false;
+    static const uint8_t signature[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+    fwrite (signature, 1, 8, f);
+
+    vector<uint8_t> ihdr;
+    put32 (ihdr, width);
+    put32 (ihdr, height);
+    ihdr.push_back (8); // bit depth
+    ihdr.push_back (6); // RGBA
+    ihdr.push_back (0);
+    ihdr.push_back (0);
+    ihdr.push_back (0);
+    write_chunk (f, "IHDR", ihdr);
+
+    /* scanlines prefixed by filter type 0 */
+    size_t stride = (size_t) width * 4;
+    vector<uint8_t> raw;
+    raw.reserve ((stride + 1) * height);
+    for (int y = 0; y < height; y++) {
+      raw.push_back (0);
+      raw.insert (raw.end (), rgba + y * stride, rgba + (y + 1) * stride);
+    }
+
+    /* zlib stream made of stored blocks */
+    vector<uint8_t> idat = { 0x78, 0x01 };
+    uint32_t s1 = 1, s2 = 0;
+    for (uint8_t b : raw) {
+      s1 = (s1 + b) % 65521;
+      s2 = (s2 + s1) % 65521;
+    }
+    size_t pos = 0;
+    do {
+      size_t len = std::min (raw.size () - pos, (size_t) 65535);
+      idat.push_back (pos + len == raw.size () ? 1 : 0);
+      idat.push_back (len & 0xff);
+      idat.push_back (len >> 8);
+      idat.push_back (~len & 0xff);
+      idat.push_back ((~len >> 8) & 0xff);
+      idat.insert (idat.end (), raw.begin () + pos, raw.begin () + pos + len);
+      pos += len;
+    } while (pos < raw.size ());
+    put32 (idat, (s2 << 16) | s1);
+    write_chunk (f, "IDAT", idat);
+    write_chunk (f, "IEND", vector<uint8_t> ());
+    return fclose (f) == 0;
+  }
+}
@@ -0,0 +1,52 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "../image_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djnn
+{
+  using namespace std;
+
+  /* non-premultiplied RGBA, 4 bytes per pixel, row by row */
+  struct SoftImage
+  {
+    int width, height;
+    vector<uint8_t> rgba;
+  };
+
+  /* a SoftImage shared through the image cache */
+  class SoftImageData : public ImageData
+  {
+  public:
+    SoftImageData (SoftImage *i) : image (i) {}
+    int width () const override { return image->width; }
+    int height () const override { return image->height; }
+    size_t bytes () const override { return image->rgba.size (); }
+    unique_ptr<SoftImage> image;
+  };
+
+  /* binary PNM (P5 grey or P6 color): the only formats read without an
+   * image library; returns nullptr otherwise */
+  SoftImage* load_pnm (const string &path);
+
+  /* uncompressed (stored deflate blocks) PNG, readable by any viewer */
+  bool write_png (const string &path, int width, int height, const uint8_t *rgba);
+}
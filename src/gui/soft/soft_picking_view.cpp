@@ -0,0 +1,61 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "soft_picking_view.h"
+
+#include <algorithm>
+
+namespace djnn
+{
+
+  SoftPickingView::SoftPickingView (Window *win) :
+      ColorPickingView (win), _width (0), _height (0)
+  {
+  }
+
+  SoftPickingView::~SoftPickingView ()
+  {
+  }
+
+  int
+  SoftPickingView::get_pixel (int x, int y)
+  {
+    if (x < 0 || x >= _width || y < 0 || y >= _height)
+      return -1;
+    return _buffer[y * _width + x];
+  }
+
+  void
+  SoftPickingView::init ()
+  {
+    ColorPickingView::init ();
+    _width = _win->width ()->get_value ();
+    _height = _win->height ()->get_value ();
+    if (_width < 0)
+      _width = 0;
+    if (_height < 0)
+      _height = 0;
+    /* the buffer is reused from one frame to the next */
+    _buffer.assign (_width * _height, 0xffffffff);
+  }
+
+  void
+  SoftPickingView::clear (int x0, int y0, int x1, int y1)
+  {
+    x0 = std::max (x0, 0);
+    x1 = std::min (x1, _width);
+    for (int y = std::max (y0, 0); y < std::min (y1, _height) && x0 < x1; y++)
+      std::fill (_buffer.begin () + y * _width + x0, _buffer.begin () + y * _width + x1, 0xffffffff);
+  }
+} /* namespace djnn */
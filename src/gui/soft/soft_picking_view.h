@@ -0,0 +1,42 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "../picking/color_picking.h"
+#include "../window.h"
+
+#include <vector>
+
+namespace djnn
+{
+
+  class SoftPickingView : public ColorPickingView
+  {
+  public:
+    SoftPickingView (Window *win);
+    virtual
+    ~SoftPickingView ();
+    virtual void init ();
+    virtual int get_pixel (int x, int y);
+    void set_pixel (int x, int y, unsigned int color) { _buffer[y * _width + x] = color; }
+    /* before a partial repaint, x1 and y1 excluded */
+    void clear (int x0, int y0, int x1, int y1);
+    int width () { return _width; }
+    int height () { return _height; }
+  private:
+    std::vector<unsigned int> _buffer;
+    int _width, _height;
+  };
+} /* namespace djnn */
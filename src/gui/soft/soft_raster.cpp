@@ -0,0 +1,515 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "soft_raster.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace djnn
+{
+  /* control point distance of a cubic approximating a quarter of circle */
+  static const double kappa = 0.5522847498;
+  static const int nb_sub_scanlines = 4;
+
+  affine_t
+  affine_t::operator* (const affine_t &m) const
+  {
+    return affine_t (a * m.a + c * m.b, b * m.a + d * m.b, a * m.c + c * m.d, b * m.c + d * m.d, a * m.e + c * m.f + e,
+                     b * m.e + d * m.f + f);
+  }
+
+  affine_t
+  affine_t::inverted () const
+  {
+    double det = a * d - b * c;
+    if (det == 0)
+      return affine_t ();
+    double id = 1 / det;
+    return affine_t (d * id, -b * id, -c * id, a * id, (c * f - d * e) * id, (b * e - a * f) * id);
+  }
+
+  double
+  affine_t::scale () const
+  {
+    return sqrt (fabs (a * d - b * c));
+  }
+
+  void
+  SoftPath::move_to (double x, double y)
+  {
+    _ops.push_back (MOVE);
+    _pts.push_back ( { x, y });
+  }
+
+  void
+  SoftPath::line_to (double x, double y)
+  {
+    if (_ops.empty ())
+      move_to (x, y);
+    _ops.push_back (LINE);
+    _pts.push_back ( { x, y });
+  }
+
+  void
+  SoftPath::quad_to (double x1, double y1, double x, double y)
+  {
+    if (_ops.empty ())
+      move_to (x1, y1);
+    _ops.push_back (QUAD);
+    _pts.push_back ( { x1, y1 });
+    _pts.push_back ( { x, y });
+  }
+
+  void
+  SoftPath::cubic_to (double x1, double y1, double x2, double y2, double x, double y)
+  {
+    if (_ops.empty ())
+      move_to (x1, y1);
+    _ops.push_back (CUBIC);
+    _pts.push_back ( { x1, y1 });
+    _pts.push_back ( { x2, y2 });
+    _pts.push_back ( { x, y });
+  }
+
+  /* the current point goes back to the start of the subpath */
+  void
+  SoftPath::close ()
+  {
+    for (int i = _ops.size () - 1, j = _pts.size () - 1; i >= 0; i--) {
+      int op = _ops[i];
+      j -= op == CUBIC ? 3 : op == QUAD ? 2 : op == CLOSE ? 0 : 1;
+      if (op == MOVE) {
+        _ops.push_back (CLOSE);
+        _pts.push_back (_pts[j + 1]);
+        return;
+      }
+    }
+  }
+
+  void
+  SoftPath::add_rect (double x, double y, double w, double h, double rx, double ry)
+  {
+    rx = std::min (fabs (rx), w / 2);
+    ry = std::min (fabs (ry), h / 2);
+    if (rx <= 0 || ry <= 0) {
+      move_to (x, y);
+      line_to (x + w, y);
+      line_to (x + w, y + h);
+      line_to (x, y + h);
+      close ();
+      return;
+    }
+    double kx = rx * kappa, ky = ry * kappa;
+    move_to (x + rx, y);
+    line_to (x + w - rx, y);
+    cubic_to (x + w - rx + kx, y, x + w, y + ry - ky, x + w, y + ry);
+    line_to (x + w, y + h - ry);
+    cubic_to (x + w, y + h - ry + ky, x + w - rx + kx, y + h, x + w - rx, y + h);
+    line_to (x + rx, y + h);
+    cubic_to (x + rx - kx, y + h, x, y + h - ry + ky, x, y + h - ry);
+    line_to (x, y + ry);
+    cubic_to (x, y + ry - ky, x + rx - kx, y, x + rx, y);
+    close ();
+  }
+
+  void
+  SoftPath::add_ellipse (double cx, double cy, double rx, double ry)
+  {
+    double kx = rx * kappa, ky = ry * kappa;
+    move_to (cx + rx, cy);
+    cubic_to (cx + rx, cy + ky, cx + kx, cy + ry, cx, cy + ry);
+    cubic_to (cx - kx, cy + ry, cx - rx, cy + ky, cx - rx, cy);
+    cubic_to (cx - rx, cy - ky, cx - kx, cy - ry, cx, cy - ry);
+    cubic_to (cx + kx, cy - ry, cx + rx, cy - ky, cx + rx, cy);
+    close ();
+  }
+
+  /* number of segments for a curve whose control polygon has the given length on screen */
+  static int
+  nb_segments (double length)
+  {
+    return std::max (2, std::min (64, (int) ceil (sqrt (length * 2))));
+  }
+
+  static double
+  dist (const point_t &p1, const point_t &p2)
+  {
+    return hypot (p2.x - p1.x, p2.y - p1.y);
+  }
+
+  void
+  SoftPath::flatten (const affine_t &m, vector<polyline_t> &lines, vector<bool> &closed) const
+  {
+    polyline_t cur;
+    bool cur_closed = false;
+    auto flush = [&] () {
+      if (!cur.empty ()) {
+        lines.push_back (cur);
+        closed.push_back (cur_closed);
+      }
+      cur.clear ();
+      cur_closed = false;
+    };
+    auto tr = [&] (const point_t &p) {
+      point_t r;
+      m.apply (p.x, p.y, r.x, r.y);
+      return r;
+    };
+    size_t j = 0;
+    for (int op : _ops) {
+      switch (op)
+        {
+        case MOVE:
+          flush ();
+          cur.push_back (tr (_pts[j++]));
+          break;
+        case LINE:
+          cur.push_back (tr (_pts[j++]));
+          break;
+        case QUAD:
+          {
+            point_t p0 = cur.back (), p1 = tr (_pts[j]), p2 = tr (_pts[j + 1]);
+            j += 2;
+            int n = nb_segments (dist (p0, p1) + dist (p1, p2));
+            for (int i = 1; i <= n; i++) {
+              double t = (double) i / n, u = 1 - t;
+              cur.push_back ( { u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x, u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y });
+            }
+          }
+          break;
+        case CUBIC:
+          {
+            point_t p0 = cur.back (), p1 = tr (_pts[j]), p2 = tr (_pts[j + 1]), p3 = tr (_pts[j + 2]);
+            j += 3;
+            int n = nb_segments (dist (p0, p1) + dist (p1, p2) + dist (p2, p3));
+            for (int i = 1; i <= n; i++) {
+              double t = (double) i / n, u = 1 - t;
+              double a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+              cur.push_back ( { a * p0.x + b * p1.x + c * p2.x + d * p3.x, a * p0.y + b * p1.y + c * p2.y + d * p3.y });
+            }
+          }
+          break;
+        case CLOSE:
+          {
+            point_t start = tr (_pts[j++]);
+            cur_closed = true;
+            flush ();
+            cur.push_back (start);
+          }
+          break;
+        }
+    }
+    if (cur.size () > 1 || cur_closed)
+      flush ();
+  }
+
+  void
+  SoftPath::bounding_box (double &x, double &y, double &w, double &h) const
+  {
+    vector<polyline_t> lines;
+    vector<bool> closed;
+    flatten (affine_t (), lines, closed);
+    double x0 = HUGE_VAL, y0 = HUGE_VAL, x1 = -HUGE_VAL, y1 = -HUGE_VAL;
+    for (auto &l : lines)
+      for (auto &p : l) {
+        x0 = std::min (x0, p.x);
+        y0 = std::min (y0, p.y);
+        x1 = std::max (x1, p.x);
+        y1 = std::max (y1, p.y);
+      }
+    if (x0 > x1) {
+      x = y = w = h = 0;
+      return;
+    }
+    x = x0;
+    y = y0;
+    w = x1 - x0;
+    h = y1 - y0;
+  }
+
+  void
+  Rasterizer::reset (int width, int height)
+  {
+    _width = width;
+    _height = height;
+    _edges.clear ();
+    if ((int) _coverage.size () < width + 2)
+      _coverage.assign (width + 2, 0);
+  }
+
+  void
+  Rasterizer::add_edge (double x0, double y0, double x1, double y1)
+  {
+    if (y0 == y1)
+      return;
+    if (y0 < y1)
+      _edges.push_back ( { x0, y0, x1, y1, 1 });
+    else
+      _edges.push_back ( { x1, y1, x0, y0, -1 });
+  }
+
+  void
+  Rasterizer::add_polygon (const polyline_t &p)
+  {
+    size_t n = p.size ();
+    if (n < 2)
+      return;
+    for (size_t i = 0; i < n; i++) {
+      const point_t &a = p[i], &b = p[(i + 1) % n];
+      add_edge (a.x, a.y, b.x, b.y);
+    }
+  }
+
+  /* the pieces of a stroke all get the same orientation, so that their
+   * union is filled by the non-zero rule */
+  void
+  Rasterizer::add_oriented (polyline_t &p)
+  {
+    double area = 0;
+    size_t n = p.size ();
+    for (size_t i = 0; i < n; i++) {
+      const point_t &a = p[i], &b = p[(i + 1) % n];
+      area += a.x * b.y - b.x * a.y;
+    }
+    if (area < 0)
+      std::reverse (p.begin (), p.end ());
+    add_polygon (p);
+  }
+
+  void
+  Rasterizer::add_disc (double cx, double cy, double r)
+  {
+    int n = std::max (8, std::min (128, (int) ceil (M_PI * r)));
+    polyline_t p;
+    for (int i = 0; i < n; i++) {
+      double a = 2 * M_PI * i / n;
+      p.push_back ( { cx + r * cos (a), cy + r * sin (a) });
+    }
+    add_oriented (p);
+  }
+
+  static vector<polyline_t>
+  dash_polyline (const polyline_t &l, bool closed, const vector<double> &dashes, double offset)
+  {
+    vector<polyline_t> pieces;
+    double total = 0;
+    for (double d : dashes)
+      total += std::max (d, 0.);
+    if (total <= 0) {
+      pieces.push_back (l);
+      return pieces;
+    }
+    size_t idx = 0;
+    double left = dashes[0];
+    offset = fmod (offset, total);
+    if (offset < 0)
+      offset += total;
+    while (offset > 0) {
+      if (offset < left) {
+        left -= offset;
+        break;
+      }
+      offset -= left;
+      idx = (idx + 1) % dashes.size ();
+      left = dashes[idx];
+    }
+    polyline_t pts (l);
+    if (closed)
+      pts.push_back (l[0]);
+    polyline_t cur;
+    bool on = (idx % 2) == 0;
+    if (on)
+      cur.push_back (pts[0]);
+    for (size_t i = 1; i < pts.size (); i++) {
+      point_t a = pts[i - 1];
+      const point_t &b = pts[i];
+      double seg = dist (a, b);
+      while (seg > left) {
+        double t = left / seg;
+        point_t m = { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+        if (on) {
+          cur.push_back (m);
+          pieces.push_back (cur);
+          cur.clear ();
+        } else
+          cur.push_back (m);
+        on = !on;
+        seg -= left;
+        a = m;
+        idx = (idx + 1) % dashes.size ();
+        left = dashes[idx];
+      }
+      left -= seg;
+      if (on)
+        cur.push_back (b);
+    }
+    if (on && cur.size () > 1)
+      pieces.push_back (cur);
+    return pieces;
+  }
+
+  void
+  Rasterizer::stroke_polyline (const polyline_t &line, bool closed, const stroke_t &s)
+  {
+    polyline_t l;
+    for (auto &p : line)
+      if (l.empty () || dist (l.back (), p) > 1e-9)
+        l.push_back (p);
+    if (closed && l.size () > 2 && dist (l.front (), l.back ()) <= 1e-9)
+      l.pop_back ();
+    double hw = s.width / 2;
+    size_t n = l.size ();
+    if (n == 0)
+      return;
+    if (n == 1) {
+      if (s.cap == CAP_ROUND)
+        add_disc (l[0].x, l[0].y, hw);
+      else if (s.cap == CAP_SQUARE) {
+        polyline_t q = { { l[0].x - hw, l[0].y - hw }, { l[0].x + hw, l[0].y - hw }, { l[0].x + hw, l[0].y + hw }, { l[0].x - hw, l[0].y + hw } };
+        add_oriented (q);
+      }
+      return;
+    }
+    size_t nb_segs = closed ? n : n - 1;
+    auto unit = [&] (size_t i) {
+      const point_t &a = l[i], &b = l[(i + 1) % n];
+      double d = dist (a, b);
+      return point_t { (b.x - a.x) / d, (b.y - a.y) / d };
+    };
+    for (size_t i = 0; i < nb_segs; i++) {
+      point_t a = l[i], b = l[(i + 1) % n], u = unit (i);
+      point_t nrm = { -u.y * hw, u.x * hw };
+      if (!closed && s.cap == CAP_SQUARE) {
+        if (i == 0)
+          a = { a.x - u.x * hw, a.y - u.y * hw };
+        if (i == nb_segs - 1)
+          b = { b.x + u.x * hw, b.y + u.y * hw };
+      }
+      polyline_t q = { { a.x + nrm.x, a.y + nrm.y }, { b.x + nrm.x, b.y + nrm.y }, { b.x - nrm.x, b.y - nrm.y }, { a.x - nrm.x, a.y - nrm.y } };
+      add_oriented (q);
+    }
+    if (!closed && s.cap == CAP_ROUND) {
+      add_disc (l[0].x, l[0].y, hw);
+      add_disc (l[n - 1].x, l[n - 1].y, hw);
+    }
+    /* joins */
+    size_t first = closed ? 0 : 1, last = closed ? n : n - 1;
+    for (size_t i = first; i < last; i++) {
+      const point_t &v = l[i];
+      point_t u1 = unit ((i + n - 1) % n), u2 = unit (i);
+      double cross = u1.x * u2.y - u1.y * u2.x;
+      double dot = u1.x * u2.x + u1.y * u2.y;
+      if (fabs (cross) < 1e-9 && dot > 0)
+        continue;
+      if (s.join == JOIN_ROUND) {
+        add_disc (v.x, v.y, hw);
+        continue;
+      }
+      double side = cross > 0 ? -1 : 1;
+      point_t o1 = { -u1.y * hw * side, u1.x * hw * side }, o2 = { -u2.y * hw * side, u2.x * hw * side };
+      if (s.join == JOIN_MITER) {
+        point_t m = { o1.x + o2.x, o1.y + o2.y };
+        double ml = hypot (m.x, m.y);
+        if (ml > 1e-9) {
+          double cos_half = (m.x * o1.x + m.y * o1.y) / (ml * hw);
+          if (cos_half > 1e-9 && 1 / cos_half <= s.miter_limit) {
+            double len = hw / cos_half;
+            polyline_t q = { v, { v.x + o1.x, v.y + o1.y }, { v.x + m.x / ml * len, v.y + m.y / ml * len }, { v.x + o2.x, v.y + o2.y } };
+            add_oriented (q);
+            continue;
+          }
+        }
+      }
+      polyline_t t = { v, { v.x + o1.x, v.y + o1.y }, { v.x + o2.x, v.y + o2.y } };
+      add_oriented (t);
+    }
+  }
+
+  void
+  Rasterizer::add_stroke (const vector<polyline_t> &lines, const vector<bool> &closed, const stroke_t &s)
+  {
+    for (size_t i = 0; i < lines.size (); i++) {
+      if (s.dashes.empty ())
+        stroke_polyline (lines[i], closed[i], s);
+      else
+        for (auto &piece : dash_polyline (lines[i], closed[i], s.dashes, s.dash_offset))
+          stroke_polyline (piece, false, s);
+    }
+  }
+
+  void
+  Rasterizer::render (bool even_odd, const span_func_t &span)
+  {
+    if (_edges.empty ())
+      return;
+    std::sort (_edges.begin (), _edges.end (), [] (const edge_t &e1, const edge_t &e2) { return e1.y0 < e2.y0; });
+    double ymin = _edges[0].y0, ymax = ymin;
+    for (auto &e : _edges)
+      ymax = std::max (ymax, e.y1);
+    int y_start = std::max (0, (int) floor (ymin)), y_end = std::min (_height - 1, (int) ceil (ymax));
+    vector<int> active;
+    vector<pair<double, int> > crossings;
+    size_t next = 0;
+    float *cov = _coverage.data ();
+    const float weight = 1.f / nb_sub_scanlines;
+    for (int y = y_start; y <= y_end; y++) {
+      int xmin = _width, xmax = -1;
+      for (int s = 0; s < nb_sub_scanlines; s++) {
+        double sy = y + (s + 0.5) / nb_sub_scanlines;
+        while (next < _edges.size () && _edges[next].y0 <= sy)
+          active.push_back (next++);
+        crossings.clear ();
+        size_t k = 0;
+        for (size_t i = 0; i < active.size (); i++) {
+          const edge_t &e = _edges[active[i]];
+          if (e.y1 <= sy)
+            continue;
+          active[k++] = active[i];
+          crossings.push_back ( { e.x0 + (sy - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0), e.dir });
+        }
+        active.resize (k);
+        std::sort (crossings.begin (), crossings.end ());
+        int winding = 0;
+        for (size_t i = 0; i + 1 < crossings.size (); i++) {
+          winding += crossings[i].second;
+          bool inside = even_odd ? (winding & 1) : winding != 0;
+          if (!inside)
+            continue;
+          double x0 = std::max (0., crossings[i].first), x1 = std::min ((double) _width, crossings[i + 1].first);
+          if (x1 <= x0)
+            continue;
+          int ix0 = (int) x0, ix1 = (int) x1;
+          if (ix0 == ix1)
+            cov[ix0] += (x1 - x0) * weight;
+          else {
+            cov[ix0] += (ix0 + 1 - x0) * weight;
+            for (int x = ix0 + 1; x < ix1; x++)
+              cov[x] += weight;
+            if (ix1 < _width)
+              cov[ix1] += (x1 - ix1) * weight;
+          }
+          xmin = std::min (xmin, ix0);
+          xmax = std::max (xmax, std::min (ix1, _width - 1));
+        }
+      }
+      if (xmax >= xmin) {
+        span (y, xmin, xmax + 1, cov);
+        std::fill (cov + xmin, cov + xmax + 2, 0.f);
+      }
+      if (next == _edges.size () && active.empty ())
+        break;
+    }
+  }
+}
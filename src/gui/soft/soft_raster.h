@@ -0,0 +1,110 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace djnn
+{
+  using namespace std;
+
+  /* 2D affine transform: x' = a x + c y + e, y' = b x + d y + f */
+  struct affine_t
+  {
+    double a, b, c, d, e, f;
+    affine_t () : a (1), b (0), c (0), d (1), e (0), f (0) {}
+    affine_t (double a, double b, double c, double d, double e, double f) : a (a), b (b), c (c), d (d), e (e), f (f) {}
+    void apply (double x, double y, double &rx, double &ry) const
+    {
+      rx = a * x + c * y + e;
+      ry = b * x + d * y + f;
+    }
+    /* (m1 * m2) (p) = m1 (m2 (p)) */
+    affine_t operator* (const affine_t &m) const;
+    affine_t inverted () const;
+    /* mean scale factor, used for the widths and the flattening tolerance */
+    double scale () const;
+  };
+
+  struct point_t
+  {
+    double x, y;
+  };
+  typedef vector<point_t> polyline_t;
+
+  /* path in user coordinates, flattened into device polylines when drawn */
+  class SoftPath
+  {
+  public:
+    void clear () { _ops.clear (); _pts.clear (); }
+    bool empty () const { return _ops.empty (); }
+    void move_to (double x, double y);
+    void line_to (double x, double y);
+    void quad_to (double x1, double y1, double x, double y);
+    void cubic_to (double x1, double y1, double x2, double y2, double x, double y);
+    void close ();
+    point_t current_point () const { return _pts.empty () ? point_t { 0, 0 } : _pts.back (); }
+    void add_rect (double x, double y, double w, double h, double rx = 0, double ry = 0);
+    void add_ellipse (double cx, double cy, double rx, double ry);
+    void flatten (const affine_t &m, vector<polyline_t> &lines, vector<bool> &closed) const;
+    void bounding_box (double &x, double &y, double &w, double &h) const;
+
+  private:
+    enum { MOVE, LINE, QUAD, CUBIC, CLOSE };
+    vector<int> _ops;
+    vector<point_t> _pts;
+  };
+
+  enum { CAP_BUTT, CAP_ROUND, CAP_SQUARE };
+  enum { JOIN_MITER, JOIN_ROUND, JOIN_BEVEL };
+
+  struct stroke_t
+  {
+    double width; // device pixels
+    int cap, join;
+    double miter_limit;
+    vector<double> dashes; // device pixels, empty for a solid line
+    double dash_offset;
+  };
+
+  /* anti-aliased scanline polygon filler: 4 sub-scanlines per row and exact
+   * horizontal coverage, over an active edge list */
+  class Rasterizer
+  {
+  public:
+    typedef function<void (int y, int x0, int x1, const float *coverage)> span_func_t;
+    void reset (int width, int height);
+    void add_polygon (const polyline_t &p);
+    void add_stroke (const vector<polyline_t> &lines, const vector<bool> &closed, const stroke_t &s);
+    /* calls span for every row touched, with the coverage of [x0, x1) */
+    void render (bool even_odd, const span_func_t &span);
+    bool empty () const { return _edges.empty (); }
+
+  private:
+    struct edge_t
+    {
+      double x0, y0, x1, y1;
+      int dir;
+    };
+    void add_edge (double x0, double y0, double x1, double y1);
+    void add_oriented (polyline_t &p);
+    void add_disc (double cx, double cy, double r);
+    void stroke_polyline (const polyline_t &l, bool closed, const stroke_t &s);
+    int _width, _height;
+    vector<edge_t> _edges;
+    vector<float> _coverage;
+  };
+}
@@ -0,0 +1,222 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#include "../backend.h"
+
+#include "soft_window.h"
+#include "soft_backend.h"
+#include "soft_image.h"
+#include "../../core/syshook/event_queue.h"
+#include "../../core/execution/graph.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace djnn
+{
+  /* the windows still alive, looked up when the posted redraw runs */
+  static std::vector<SoftWindow*> windows;
+  static std::atomic<bool> redraw_posted (false);
+
+  SoftWindow::SoftWindow (Window *win, const std::string& title, double x, double y, double w, double h) :
+      _window (win), _picking_view (nullptr), _geometric_picking (nullptr), _picking (nullptr), _width (0), _height (0), _please_update (true), _mouse_x (0), _mouse_y (0), _full_colors (0)
+  {
+    _picking_view = new SoftPickingView (win);
+    _geometric_picking = new GeometricPicking (win);
+    _picking = _picking_view;
+  }
+
+  SoftWindow::~SoftWindow ()
+  {
+    windows.erase (std::remove (windows.begin (), windows.end (), this), windows.end ());
+    delete _picking_view;
+    delete _geometric_picking;
+  }
+
+  void
+  SoftWindow::set_picking_mode (picking_mode_t m)
+  {
+    Picking *p = m == GEOMETRIC_PICKING ? (Picking*) _geometric_picking : _picking_view;
+    if (p == _picking)
+      return;
+    _picking = p;
+    /* the picking view left is not up to date any more */
+    _window->damage ().add_all ();
+    update ();
+  }
+
+  void
+  SoftWindow::activate ()
+  {
+    if (std::find (windows.begin (), windows.end (), this) == windows.end ())
+      windows.push_back (this);
+    update ();
+  }
+
+  void
+  SoftWindow::deactivate ()
+  {
+    windows.erase (std::remove (windows.begin (), windows.end (), this), windows.end ());
+  }
+
+  void
+  SoftWindow::update ()
+  {
+    _please_update = true;
+    /* one redraw for all the updates until the queue is drained */
+    if (!redraw_posted.exchange (true))
+      EventQueue::instance ().post (&SoftWindow::check_for_updates);
+  }
+
+  void
+  SoftWindow::check_for_updates ()
+  {
+    redraw_posted = false;
+    for (auto w : windows) {
+      if (w->_please_update)
+        w->redraw ();
+    }
+  }
+
+  void
+  SoftWindow::redraw ()
+  {
+    _please_update = false;
+    DamageRegion &damage = _window->damage ();
+    int w = std::max (0., _window->width ()->get_value ());
+    int h = std::max (0., _window->height ()->get_value ());
+    if (w != _width || h != _height) {
+      _width = w;
+      _height = h;
+      _pixels.resize ((size_t) w * h * 4);
+      damage.add_all ();
+    }
+    SoftBackend* backend = SoftBackend::instance ();
+    backend->set_window (_window);
+    backend->set_target (_pixels.data (), _width, _height);
+    /* the color picking view is drawn by update_picking, when a pick needs it */
+    bool geometric = _picking == _geometric_picking;
+    backend->set_picking_view (geometric ? _picking : nullptr);
+    if (geometric)
+      _geometric_picking->init ();
+    Process *p = _window->get_parent ();
+    if (p && !damage.all ()) {
+      backend->set_damage_pass (AbstractBackend::BOUNDS_PASS);
+      p->draw ();
+      /* clipping every span is not worth it past that */
+      if (damage.area (_width, _height) > (double) _width * _height / 2)
+        damage.add_all ();
+    }
+    double area = 0;
+    if (damage.all ()) {
+      std::fill (_pixels.begin (), _pixels.end (), 0xff);
+      if (geometric)
+        _geometric_picking->init ();
+      backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+      if (p)
+        p->draw ();
+      area = (double) _width * _height;
+    } else if (!damage.empty ()) {
+      for (auto &r : damage.rects ()) {
+        int x0 = std::max (r.x0, 0), x1 = std::min (r.x1, _width);
+        for (int y = std::max (r.y0, 0); y < std::min (r.y1, _height) && x0 < x1; y++)
+          std::fill (&_pixels[((size_t) y * _width + x0) * 4], &_pixels[((size_t) y * _width + x1) * 4], 0xff);
+      }
+      backend->set_damage_pass (AbstractBackend::PARTIAL_REPAINT);
+      if (p)
+        p->draw ();
+      area = damage.area (_width, _height);
+    }
+    backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+    backend->set_target (nullptr, 0, 0);
+    backend->set_picking_view (nullptr);
+    damage.clear ();
+    _window->damaged_area ()->set_value (area, true);
+    if (_picking->genericCheckShapeAfterDraw (_mouse_x, _mouse_y) || _window->damaged_area ()->has_coupling ())
+      GRAPH_EXEC;
+  }
+
+  void
+  SoftWindow::update_picking ()
+  {
+    DamageRegion &pick = _window->pick_damage ();
+    Process *p = _window->get_parent ();
+    if (pick.empty () || _picking != _picking_view)
+      return;
+    /* the colors of the shapes gone are only released when it is drawn whole */
+    if (_picking_view->width () != _width || _picking_view->height () != _height
+        || _picking_view->num_colors () > 2 * _full_colors + 256)
+      pick.add_all ();
+    if (pick.all ())
+      _picking_view->init ();
+    else {
+      for (auto &r : pick.rects ())
+        _picking_view->clear (r.x0, r.y0, r.x1, r.y1);
+    }
+    SoftBackend* backend = SoftBackend::instance ();
+    backend->set_window (_window);
+    backend->set_target (_pixels.data (), _width, _height);
+    backend->set_picking_view (_picking_view);
+    backend->set_damage_pass (AbstractBackend::PICKING_PASS);
+    if (p)
+      p->draw ();
+    backend->set_damage_pass (AbstractBackend::FULL_REPAINT);
+    backend->set_target (nullptr, 0, 0);
+    backend->set_picking_view (nullptr);
+    if (pick.all ())
+      _full_colors = _picking_view->num_colors ();
+    pick.clear ();
+  }
+
+  bool
+  SoftWindow::save_png (const std::string &path)
+  {
+    return write_png (path, _width, _height, _pixels.data ());
+  }
+
+  void
+  SoftWindow::mouse_press (double x, double y, int button)
+  {
+    _mouse_x = x;
+    _mouse_y = y;
+    if (_picking->genericMousePress (x, y, button))
+      GRAPH_EXEC;
+  }
+
+  void
+  SoftWindow::mouse_move (double x, double y)
+  {
+    _mouse_x = x;
+    _mouse_y = y;
+    if (_picking->genericMouseMove (x, y))
+      GRAPH_EXEC;
+  }
+
+  void
+  SoftWindow::mouse_release (double x, double y, int button)
+  {
+    _mouse_x = x;
+    _mouse_y = y;
+    if (_picking->genericMouseRelease (x, y, button))
+      GRAPH_EXEC;
+  }
+
+  void
+  SoftWindow::mouse_wheel (double dx, double dy)
+  {
+    if (_picking->genericMouseWheel (dx, dy))
+      GRAPH_EXEC;
+  }
+
+}
@@ -0,0 +1,74 @@
+/*
+ *  djnn v2
+ *
+ *  The copyright holders for the contents of this file are:
+ *      Ecole Nationale de l'Aviation Civile, France (2018)
+ *  See file "license.terms" for the rights and conditions
+ *  defined by copyright holders.
+ *
+ *
+ *  Contributors:
+ *      Mathieu Magnaudet <mathieu.magnaudet@enac.fr>
+ *
+ */
+
+#pragma once
+
+#include "../backend.h"
+
+#include "../window.h"
+#include "soft_picking_view.h"
+#include "../picking/geometric_picking.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace djnn {
+
+  /* A window without a screen: the scene is drawn into an RGBA framebuffer
+   * when the main loop drains its event queue, and the pointer events are
+   * injected by the program. */
+  class SoftWindow : public WinImpl
+  {
+  public:
+    SoftWindow (Window *win, const std::string& title, double x, double y, double w, double h);
+    virtual ~SoftWindow ();
+    void update () override;
+    /* with the exclusive access held */
+    void redraw ();
+    bool save_png (const std::string &path);
+    const uint8_t* pixels () const { return _pixels.data (); }
+    int width () const { return _width; }
+    int height () const { return _height; }
+    Picking* picking_view () { return _picking; }
+    void set_picking_mode (picking_mode_t m) override;
+    void update_picking () override;
+
+    /* pointer events, with the exclusive access held */
+    void mouse_press (double x, double y, int button);
+    void mouse_move (double x, double y);
+    void mouse_release (double x, double y, int button);
+    void mouse_wheel (double dx, double dy);
+
+    /* redraws the windows that asked for it */
+    static void check_for_updates ();
+
+  protected:
+    void activate () override;
+    void deactivate () override;
+
+  private:
+    Window* _window;
+    SoftPickingView *_picking_view;
+    GeometricPicking *_geometric_picking;
+    Picking *_picking; // one of the two above
+    std::vector<uint8_t> _pixels;
+    int _width, _height;
+    bool _please_update;
+    double _mouse_x, _mouse_y;
+    /* colors in the picking view after it was last drawn whole */
+    size_t _full_colors;
+  };
+
+}
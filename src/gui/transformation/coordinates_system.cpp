@@ -29,22 +29,14 @@ namespace djnn
   void
   ScreenToLocal::stl_action::activate () {
 
-    if (_stl->_shape->inverted_matrix () == nullptr)
-      warning (this, "ScreenToLocal::stl_action::activate - inverted_matrix has not been initialized");
-    else {
-      Homography *hi = dynamic_cast<Homography*> (_stl->_shape->inverted_matrix ());
-
-      double resultX = hi->_m11->get_value () * _stl->_inX->get_value () + 
-                       hi->_m12->get_value () * _stl->_inY->get_value () + 
-                       hi->_m14->get_value () - _stl->_shape->origin_x ()->get_value () ;
-      double resultY = hi->_m21->get_value () * _stl->_inX->get_value () + 
-                       hi->_m22->get_value () * _stl->_inY->get_value () +
-                       hi->_m24->get_value () - _stl->_shape->origin_y ()->get_value ();
-
-      _stl->_outX->set_value (resultX, true);
-      _stl->_outY->set_value (resultY, true);
-    }
-      
+    double resultX, resultY;
+    _stl->_shape->window_to_local (_stl->_inX->get_value (), _stl->_inY->get_value (), resultX, resultY);
+    resultX -= _stl->_shape->origin_x ()->get_value ();
+    resultY -= _stl->_shape->origin_y ()->get_value ();
+
+    _stl->_outX->set_value (resultX, true);
+    _stl->_outY->set_value (resultY, true);
+
   }
 
   ScreenToLocal::ScreenToLocal (Process *p, const string &n, Process* shape) :
@@ -54,9 +46,6 @@ namespace djnn
     if (_shape == nullptr)
       warning (this, "screenToLocal - shape has to be a graphical shape Rectangle|Circle ..." );
 
-    //FIXME : hack to create matrix
-    _shape->find_component("press");
-
     _inX = new DoubleProperty (this, "inX", 0);
     _inY = new DoubleProperty (this, "inY", 0);
     _outX = new DoubleProperty (this, "outX", 0);
@@ -113,24 +102,14 @@ namespace djnn
   void
   LocalToScreen::lts_action::activate () {
 
-    if (_lts->_shape->matrix () == nullptr)
-      warning (this, "LocalToScreen::stl_action::activate - matrix has not been initialized");
-    else {
-      Homography *h = dynamic_cast<Homography*> (_lts->_shape->matrix ());
-
-      double x = _lts->_inX->get_value () + _lts->_shape->origin_x ()->get_value ();
-      double y = _lts->_inY->get_value () + _lts->_shape->origin_y ()->get_value ();
-      double resultX = h->_m11->get_value () * x + 
-                       h->_m12->get_value () * y + 
-                       h->_m14->get_value () ;
-      double resultY = h->_m21->get_value () * x + 
-                       h->_m22->get_value () * y +
-                       h->_m24->get_value () ;
-
-      _lts->_outX->set_value (resultX, true);
-      _lts->_outY->set_value (resultY, true);
-    }
-      
+    double x = _lts->_inX->get_value () + _lts->_shape->origin_x ()->get_value ();
+    double y = _lts->_inY->get_value () + _lts->_shape->origin_y ()->get_value ();
+    double resultX, resultY;
+    _lts->_shape->local_to_window (x, y, resultX, resultY);
+
+    _lts->_outX->set_value (resultX, true);
+    _lts->_outY->set_value (resultY, true);
+
   }
 
   LocalToScreen::LocalToScreen (Process *p, const string &n, Process* shape) :
@@ -140,9 +119,6 @@ namespace djnn
     if (_shape == nullptr)
       warning (this, "LocalToScreen - shape has to be a graphical shape Rectangle|Circle ..." );
 
-    //FIXME : hack to create matrix
-    _shape->find_component("press");
-
     _inX = new DoubleProperty (this, "inX", 0);
     _inY = new DoubleProperty (this, "inY", 0);
     _outX = new DoubleProperty (this, "outX", 0);
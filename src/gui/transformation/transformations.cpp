@@ -1099,25 +1099,6 @@ namespace djnn
     if (_cm43) {delete _cm43; _cm43 = nullptr;}
     if (_cm44) {delete _cm44; _cm44 = nullptr;}
 
-    if (_m11) {delete _m11; _m11 = nullptr;}
-    if (_m12) {delete _m12; _m12 = nullptr;}
-    if (_m13) {delete _m13; _m13 = nullptr;}
-    if (_m14) {delete _m14; _m14 = nullptr;}
-
-    if (_m21) {delete _m21; _m21 = nullptr;}
-    if (_m22) {delete _m22; _m22 = nullptr;}
-    if (_m23) {delete _m23; _m23 = nullptr;}
-    if (_m24) {delete _m24; _m24 = nullptr;}
-
-    if (_m31) {delete _m31; _m31 = nullptr;}
-    if (_m32) {delete _m32; _m32 = nullptr;}
-    if (_m33) {delete _m33; _m33 = nullptr;}
-    if (_m34) {delete _m34; _m34 = nullptr;}
-
-    if (_m41) {delete _m41; _m41 = nullptr;}
-    if (_m42) {delete _m42; _m42 = nullptr;}
-    if (_m43) {delete _m43; _m43 = nullptr;}
-    if (_m44) {delete _m44; _m44 = nullptr;}
 
     /* translate BY - Becarfull of the order */
     if (_parent && _parent->state_dependency () != nullptr)
@@ -1155,7 +1136,7 @@ namespace djnn
     if (_scaleBy_cy_coupling) {delete _scaleBy_cy_coupling; _scaleBy_cy_coupling=nullptr;}
     if (_scaleBy_sx_coupling) {delete _scaleBy_sx_coupling; _scaleBy_sx_coupling=nullptr;}
     if (_scaleBy_sy_coupling) {delete _scaleBy_sy_coupling; _scaleBy_sy_coupling=nullptr;}
-    if (_scaleBy_action) {delete _translateBy_action; _translateBy_action=nullptr;}
+    if (_scaleBy_action) {delete _scaleBy_action; _scaleBy_action=nullptr;}
     if (_scaleBy_cx) {delete _scaleBy_cx; _scaleBy_cx=nullptr;}
     if (_scaleBy_cy) {delete _scaleBy_cy; _scaleBy_cy=nullptr;}
     if (_scaleBy_sx) {delete _scaleBy_sx; _scaleBy_sx=nullptr;}
@@ -1225,6 +1206,27 @@ namespace djnn
     if (_skew_Y_By_da) {delete _skew_Y_By_da; _skew_Y_By_da=nullptr;}
     if (_skew_Y_By_spike) {delete _skew_Y_By_spike; _skew_Y_By_spike=nullptr;}
 
+    /* once the edges to the matrix are removed */
+    if (_m11) {delete _m11; _m11 = nullptr;}
+    if (_m12) {delete _m12; _m12 = nullptr;}
+    if (_m13) {delete _m13; _m13 = nullptr;}
+    if (_m14) {delete _m14; _m14 = nullptr;}
+
+    if (_m21) {delete _m21; _m21 = nullptr;}
+    if (_m22) {delete _m22; _m22 = nullptr;}
+    if (_m23) {delete _m23; _m23 = nullptr;}
+    if (_m24) {delete _m24; _m24 = nullptr;}
+
+    if (_m31) {delete _m31; _m31 = nullptr;}
+    if (_m32) {delete _m32; _m32 = nullptr;}
+    if (_m33) {delete _m33; _m33 = nullptr;}
+    if (_m34) {delete _m34; _m34 = nullptr;}
+
+    if (_m41) {delete _m41; _m41 = nullptr;}
+    if (_m42) {delete _m42; _m42 = nullptr;}
+    if (_m43) {delete _m43; _m43 = nullptr;}
+    if (_m44) {delete _m44; _m44 = nullptr;}
+
   }
 
   void
@@ -25,6 +25,7 @@ namespace djnn
   void
   Window::init_ui (const std::string &title, double x, double y, double w, double h)
   {
+    set_main_thread_only ();
     _pos_x = new DoubleProperty (this, "x", x);
     _pos_y = new DoubleProperty (this, "y", y);
     _width = new DoubleProperty (this, "width", w);
@@ -34,6 +35,7 @@ namespace djnn
     _key_released = new IntProperty (this, "key-released", 0);
     _key_pressed_text = new TextProperty (this, "key-pressed_text", "");
     _key_released_text = new TextProperty (this, "key-released_text", "");
+    _damaged_area = new DoubleProperty (this, "damaged_area", 0);
     _close = new Spike;
     add_symbol ("close", _close);
     _cpnt_type = WINDOW;
@@ -90,6 +92,7 @@ namespace djnn
     delete _release;
     delete _move;
     delete _wheel;
+    delete _damaged_area;
     delete _win_impl;
   }
 
@@ -17,12 +17,18 @@
 #include "../core/tree/double_property.h"
 #include "../core/tree/text_property.h"
 #include "../core/tree/process.h"
+#include "damage.h"
 
 #include <iostream>
 
 namespace djnn
 {
 
+  /* how the shape under the pointer is found: in an offscreen image where
+   * each shape is drawn in a color of its own, or from the geometry of the
+   * shapes (see GeometricPicking) */
+  enum picking_mode_t { COLOR_PICKING, GEOMETRIC_PICKING };
+
   class WinImpl {
   public:
     WinImpl () {}
@@ -30,6 +36,9 @@ namespace djnn
     virtual void activate () = 0;
     virtual void deactivate () = 0;
     virtual void update () = 0;
+    virtual void set_picking_mode (picking_mode_t m) {}
+    /* draws the color picking view where it is out of date */
+    virtual void update_picking () {}
   };
 
   class Window : public Process
@@ -55,6 +64,8 @@ namespace djnn
     void set_refresh (bool r) { _refresh = r; }
     bool refresh () { return _refresh; }
     void update () { _win_impl->update (); };
+    /* the next frame picks with the new mode */
+    void set_picking_mode (picking_mode_t m) { _win_impl->set_picking_mode (m); }
     void activate () override { _win_impl->activate (); }
     void deactivate () override { _win_impl->deactivate (); }
     Process* press () { return _press; }
@@ -67,6 +78,12 @@ namespace djnn
     DoubleProperty* move_x () { return _move_x; }
     DoubleProperty* move_y () { return _move_y; }
     void set_frame ();
+    /* what the next frame has to repaint, see AbstractGShape::update_box */
+    DamageRegion& damage () { return _damage; }
+    /* where the color picking view no longer matches the shapes */
+    DamageRegion& pick_damage () { return _pick_damage; }
+    /* pixels repainted by the last frame */
+    DoubleProperty* damaged_area () { return _damaged_area; }
     
   private:
     void init_ui (const std::string &title, double x, double y, double w, double h);
@@ -91,7 +108,9 @@ namespace djnn
     IntProperty *_key_pressed;
     TextProperty *_key_released_text;
     IntProperty *_key_released;
+    DoubleProperty *_damaged_area;
     WinImpl *_win_impl;
+    DamageRegion _damage, _pick_damage;
     bool _refresh;
   };
 
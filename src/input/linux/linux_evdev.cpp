@@ -64,6 +64,7 @@ namespace djnn {
     }
     // FIXME: this should be done lazily
     _iofd = new IOFD (_fd);
+    _iofd->set_edge_triggered (true); // handle_evdev_msg reads until EAGAIN
     _iofd->activation ();
     _action = new EvdevAction (this);
     _readable_cpl = new Coupling (_iofd->find_component ("readable"), ACTIVATION, _action, ACTIVATION);
@@ -89,18 +90,28 @@ namespace djnn {
   Evdev::handle_evdev_msg ()
   {
     int err;
+    int flag = LIBEVDEV_READ_FLAG_NORMAL;
     struct input_event ev;
 
-    do {
-      err = libevdev_next_event (_dev, LIBEVDEV_READ_FLAG_NORMAL, &ev);
-      if (err == LIBEVDEV_READ_STATUS_SYNC) {
-        warning (nullptr, "input events may have been lost for device " + _name);
-      } else if (err == LIBEVDEV_READ_STATUS_SUCCESS) {
+    /* the fd is edge-triggered: nothing wakes us up again until it has been
+     * drained, so read up to EAGAIN, resyncing on the way if needed */
+    for (;;) {
+      err = libevdev_next_event (_dev, flag, &ev);
+      if (err == LIBEVDEV_READ_STATUS_SUCCESS) {
         _djn_dev->handle_event (&ev);
+      } else if (err == LIBEVDEV_READ_STATUS_SYNC) {
+        if (flag == LIBEVDEV_READ_FLAG_NORMAL) {
+          /* ev is the SYN_DROPPED: the next events bring the device up to date */
+          warning (nullptr, "input events may have been lost for device " + _name);
+          flag = LIBEVDEV_READ_FLAG_SYNC;
+        } else
+          _djn_dev->handle_event (&ev);
+      } else if (err == -EAGAIN && flag == LIBEVDEV_READ_FLAG_SYNC) {
+        /* in sync again, back to the pending events */
+        flag = LIBEVDEV_READ_FLAG_NORMAL;
+      } else if (err != -EINTR) {
+        return;
       }
-    } while (err == LIBEVDEV_READ_STATUS_SUCCESS);
-    if (err != -EAGAIN && err != -EINTR) {
-      return;
     }
   }
 }